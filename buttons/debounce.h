@@ -0,0 +1,178 @@
+// Debounce dos botões por pino. Cada botão interrompe nas duas bordas; a
+// primeira borda desliga a interrupção do pino e arma um alarme do timer em
+// hardware. Quando o alarme dispara, o nível do pino já estabilizou: ele é
+// lido, a interrupção volta a ser ligada e, se o nível mudou, o evento é
+// entregue. Segurar o botão não gera interrupções, e cada botão tem o seu
+// próprio estado, sem bloquear os demais.
+//
+// O botão BOOTSEL da placa não tem interrupção: ele é lido periodicamente e
+// passa pela mesma máquina de estados com button_poll
+
+#include "pico/time.h"
+
+// Tempo para o nível do pino estabilizar depois de uma borda
+#define BUTTON_DEBOUNCE_US 5000
+// Tempo pressionado até o evento de segurar
+#define BUTTON_HOLD_US 800000
+// Intervalo máximo entre soltar e pressionar de novo para um duplo clique
+#define BUTTON_DOUBLE_US 300000
+
+// Quantidade máxima de botões acompanhados
+#define BUTTON_MAX 4
+// Identificador do botão BOOTSEL, que não corresponde a um GPIO
+#define BUTTON_BOARD 0xFF
+
+typedef enum {
+  BUTTON_EVENT_PRESS,
+  BUTTON_EVENT_RELEASE,
+  // Continua pressionado depois de BUTTON_HOLD_US
+  BUTTON_EVENT_HOLD,
+  // Segunda pressão logo depois de um clique, entregue após BUTTON_EVENT_PRESS
+  BUTTON_EVENT_DOUBLE,
+} button_event_t;
+
+// Recebe os eventos, no contexto da interrupção do GPIO ou do timer (ou de
+// quem chamar button_poll). time_us é o instante da primeira borda da
+// mudança, antes do debounce, ou do alarme no caso de segurar
+typedef void (*button_event_cb_t)(uint button, button_event_t event, uint32_t time_us);
+
+typedef struct {
+  uint id;
+  volatile bool pressed;
+  // Última leitura de button_poll, para exigir duas leituras iguais
+  bool sample;
+  bool double_armed;
+  uint64_t release_time;
+  // Instante da primeira borda ainda não confirmada pelo debounce
+  uint32_t edge_time;
+  alarm_id_t debounce_alarm;
+  alarm_id_t hold_alarm;
+} button_t;
+
+static button_t buttons[BUTTON_MAX];
+static uint button_count = 0;
+static button_event_cb_t button_event_cb;
+
+#define BUTTON_EDGES (GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE)
+
+static button_t *button_find(uint id) {
+  for (uint i = 0; i < button_count; ++i) {
+    if (buttons[i].id == id) return &buttons[i];
+  }
+  return NULL;
+}
+
+static int64_t button_hold_alarm(alarm_id_t id, void *user_data) {
+  (void)id;
+  button_t *button = user_data;
+  button->hold_alarm = 0;
+  if (button->pressed) {
+    // Um clique seguido de segurar não conta para o duplo clique
+    button->double_armed = false;
+    button_event_cb(button->id, BUTTON_EVENT_HOLD, time_us_32());
+  }
+  return 0;
+}
+
+// Aplica um nível já estável ao botão e entrega os eventos
+static void button_update(button_t *button, bool pressed, uint32_t time_us) {
+  if (pressed == button->pressed) return;
+  button->pressed = pressed;
+  uint64_t now = time_us_64();
+
+  if (pressed) {
+    bool double_press = button->double_armed &&
+      now - button->release_time < BUTTON_DOUBLE_US;
+    // Um terceiro clique começa uma nova sequência
+    button->double_armed = !double_press;
+
+    button->hold_alarm = add_alarm_in_us(BUTTON_HOLD_US, button_hold_alarm, button, true);
+    button_event_cb(button->id, BUTTON_EVENT_PRESS, time_us);
+    if (double_press) {
+      button_event_cb(button->id, BUTTON_EVENT_DOUBLE, time_us);
+    }
+  } else {
+    if (button->hold_alarm > 0) {
+      cancel_alarm(button->hold_alarm);
+      button->hold_alarm = 0;
+    }
+    button->release_time = now;
+    button_event_cb(button->id, BUTTON_EVENT_RELEASE, time_us);
+  }
+}
+
+static int64_t button_debounce_alarm(alarm_id_t id, void *user_data) {
+  (void)id;
+  button_t *button = user_data;
+  button->debounce_alarm = 0;
+
+  // Descarta as bordas do ressalto e volta a escutar o pino antes de ler o
+  // nível: uma mudança depois da leitura gera uma nova interrupção
+  gpio_acknowledge_irq(button->id, BUTTON_EDGES);
+  gpio_set_irq_enabled(button->id, BUTTON_EDGES, true);
+  button_update(button, !gpio_get(button->id), button->edge_time);
+  return 0;
+}
+
+static void button_irq_handler(uint gpio, uint32_t events) {
+  (void)events;
+  button_t *button = button_find(gpio);
+  if (!button) return;
+
+  // Ignora o ressalto até o alarme conferir o nível
+  button->edge_time = time_us_32();
+  gpio_set_irq_enabled(gpio, BUTTON_EDGES, false);
+  button->debounce_alarm = add_alarm_in_us(
+    BUTTON_DEBOUNCE_US, button_debounce_alarm, button, true
+  );
+
+  // Sem alarme livre, a interrupção volta a ser ligada e o nível lido
+  // agora é aplicado sem debounce, em vez de deixar o botão mudo
+  if (button->debounce_alarm < 0) {
+    button->debounce_alarm = 0;
+    gpio_acknowledge_irq(gpio, BUTTON_EDGES);
+    gpio_set_irq_enabled(gpio, BUTTON_EDGES, true);
+    button_update(button, !gpio_get(gpio), button->edge_time);
+  }
+}
+
+// Reserva o estado de um botão. Retorna NULL se já houver BUTTON_MAX
+static button_t *button_add(uint id) {
+  if (button_count == BUTTON_MAX) return NULL;
+  button_t *button = &buttons[button_count++];
+  button->id = id;
+  return button;
+}
+
+// Acompanha um botão ligado ao GPIO, ativo em nível baixo. Retorna false
+// se não houver espaço para mais um botão
+bool button_watch(uint gpio) {
+  button_t *button = button_add(gpio);
+  if (!button) return false;
+  button->pressed = !gpio_get(gpio);
+  gpio_set_irq_enabled_with_callback(gpio, BUTTON_EDGES, true, &button_irq_handler);
+  return true;
+}
+
+// Acompanha um botão lido periodicamente por button_poll. Retorna false
+// se não houver espaço para mais um botão
+bool button_watch_polled(uint id) {
+  return button_add(id) != NULL;
+}
+
+void button_set_event_callback(button_event_cb_t callback) {
+  button_event_cb = callback;
+}
+
+// Entrega a leitura de um botão sem interrupção. O nível só é aceito depois
+// de duas leituras seguidas iguais, então o intervalo entre chamadas deve
+// ser maior que o ressalto
+void button_poll(uint id, bool pressed) {
+  button_t *button = button_find(id);
+  if (!button) return;
+
+  if (pressed == button->sample) {
+    button_update(button, pressed, time_us_32());
+  }
+  button->sample = pressed;
+}
@@ -0,0 +1,62 @@
+// Fila de eventos dos botões, das interrupções para o laço principal. É um
+// anel de produtor único e consumidor único, sem trava: só o produtor
+// escreve head e só o consumidor escreve tail.
+//
+// Os produtores são as interrupções do GPIO e do timer, que não se
+// interrompem entre si; quem produzir fora de interrupção deve desligá-las
+// durante o event_queue_push. O consumidor é o laço principal
+
+#include "hardware/sync.h"
+
+// Capacidade da fila; precisa ser potência de 2
+#define EVENT_QUEUE_SIZE 32
+
+typedef struct {
+  // Instante da entrada que gerou o evento, em microssegundos desde a
+  // inicialização
+  uint32_t time_us;
+  uint8_t button;
+  uint8_t event;
+} input_event_t;
+
+typedef struct {
+  input_event_t events[EVENT_QUEUE_SIZE];
+  volatile uint32_t head;
+  volatile uint32_t tail;
+  // Eventos descartados por falta de espaço
+  volatile uint32_t overflows;
+} event_queue_t;
+
+// Insere um evento; com a fila cheia, o evento é descartado e contado
+bool event_queue_push(event_queue_t *queue, uint button, uint event, uint32_t time_us) {
+  uint32_t head = queue->head;
+  if (head - queue->tail == EVENT_QUEUE_SIZE) {
+    queue->overflows++;
+    return false;
+  }
+
+  input_event_t *slot = &queue->events[head % EVENT_QUEUE_SIZE];
+  slot->time_us = time_us;
+  slot->button = button;
+  slot->event = event;
+  // O evento precisa estar completo antes de ficar visível ao consumidor
+  __dmb();
+  queue->head = head + 1;
+  return true;
+}
+
+// Lê o evento mais antigo sem retirá-lo. Retorna false com a fila vazia
+bool event_queue_peek(event_queue_t *queue, input_event_t *event) {
+  uint32_t tail = queue->tail;
+  if (tail == queue->head) return false;
+  __dmb();
+  *event = queue->events[tail % EVENT_QUEUE_SIZE];
+  return true;
+}
+
+// Retira o evento mais antigo, já lido com event_queue_peek
+void event_queue_pop(event_queue_t *queue) {
+  // A leitura do evento termina antes de liberar a posição ao produtor
+  __dmb();
+  queue->tail = queue->tail + 1;
+}
@@ -0,0 +1,68 @@
+#include "console.h"
+#include "font.h"
+#include <string.h>
+
+void ssd1306_console_init(ssd1306_console_t *console, ssd1306_t *ssd) {
+  console->ssd = ssd;
+  console->rows = ssd->pages;
+  ssd1306_console_clear(console);
+}
+
+void ssd1306_console_clear(ssd1306_console_t *console) {
+  ssd1306_fill(console->ssd, false);
+  ssd1306_set_start_line(console->ssd, 0);
+  console->top = 0;
+  console->row = 0;
+  console->column = 0;
+}
+
+// Página da GDDRAM onde está a linha do cursor
+static uint8_t ssd1306_console_page(ssd1306_console_t *console) {
+  return (console->top + console->row) % console->rows;
+}
+
+void ssd1306_console_newline(ssd1306_console_t *console) {
+  ssd1306_t *ssd = console->ssd;
+  console->column = 0;
+
+  if (console->row + 1 < console->rows) {
+    console->row++;
+    return;
+  }
+
+  // Tela cheia: a linha mais antiga sai pelo topo e sua página passa a
+  // ser a última linha. Só essa página e a linha inicial vão para o
+  // barramento no próximo envio
+  uint8_t page = console->top;
+  console->top = (console->top + 1) % console->rows;
+  ssd1306_set_start_line(ssd, console->top * 8);
+
+  memset(&ssd->ram_buffer[page * ssd->width], 0, ssd->width);
+  ssd1306_mark_dirty(ssd, 0, ssd->width - 1, page, page);
+}
+
+void ssd1306_console_putc(ssd1306_console_t *console, char c) {
+  if (c == '\n') {
+    ssd1306_console_newline(console);
+    return;
+  }
+  if (c == '\r') {
+    console->column = 0;
+    return;
+  }
+
+  // Quebra a linha quando o próximo caractere não cabe
+  if ((console->column + 1) * FONT_GLYPH_WIDTH > console->ssd->width) {
+    ssd1306_console_newline(console);
+  }
+  ssd1306_draw_char(console->ssd, c, 
+    console->column * FONT_GLYPH_WIDTH, ssd1306_console_page(console) * 8
+  );
+  console->column++;
+}
+
+void ssd1306_console_write(ssd1306_console_t *console, const char *str) {
+  while (*str) {
+    ssd1306_console_putc(console, *str++);
+  }
+}
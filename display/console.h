@@ -0,0 +1,27 @@
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+#include "ssd1306.h"
+
+// Console de texto sobre o display: uma linha de texto por página. Quando
+// a tela enche, a página da linha mais antiga é reaproveitada para a nova
+// linha e a linha inicial do controlador (SET_DISP_START_LINE) avança uma
+// página, rolando a imagem sem reenviar o restante da tela
+typedef struct {
+  ssd1306_t *ssd;
+  // Quantidade de linhas de texto (páginas do display)
+  uint8_t rows;
+  // Página da GDDRAM exibida no topo da tela
+  uint8_t top;
+  // Linha do cursor, contada a partir do topo, e coluna em caracteres
+  uint8_t row;
+  uint8_t column;
+} ssd1306_console_t;
+
+void ssd1306_console_init(ssd1306_console_t *console, ssd1306_t *ssd);
+void ssd1306_console_clear(ssd1306_console_t *console);
+void ssd1306_console_newline(ssd1306_console_t *console);
+void ssd1306_console_putc(ssd1306_console_t *console, char c);
+void ssd1306_console_write(ssd1306_console_t *console, const char *str);
+
+#endif
@@ -1,296 +1,1103 @@
+// Compilador da fonte do display.
+//
+// Os caracteres são desenhados aqui como matrizes 8x8 (1 = pixel aceso) e
+// convertidos, durante a compilação do firmware, no cabeçalho font.h usado
+// por display/ssd1306.c. Uso:
+//
+//   make_font [-p] <saída>
+//
+// -p inclui as larguras de cada caractere, usadas no texto proporcional.
+
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #define ROWS 8
 #define COLS 8
 
-int frames[][ROWS][COLS] = {
-    { // a
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 1, 1, 1, 1, 0, 0},
-        {0, 1, 1, 0, 0, 1, 1, 0},
-        {0, 1, 0, 0, 0, 0, 1, 0},
-        {0, 1, 1, 0, 0, 1, 1, 0},
-        {1, 0, 1, 1, 1, 1, 0, 1}
-    },
-    { // b
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 1, 0, 0, 0, 0, 0},
-        {0, 0, 1, 0, 0, 0, 0, 0},
-        {0, 0, 1, 0, 0, 0, 0, 0},
-        {0, 0, 1, 1, 1, 1, 0, 0},
-        {0, 0, 1, 0, 0, 1, 0, 0},
-        {0, 0, 1, 0, 0, 1, 0, 0},
-        {0, 0, 1, 1, 1, 1, 0, 0}
-    },
-    { // c
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 1, 1, 1, 1, 0, 0},
-        {0, 0, 1, 0, 0, 0, 0, 0},
-        {0, 0, 1, 0, 0, 0, 0, 0},
-        {0, 0, 1, 1, 1, 1, 0, 0}
-    },
-    { // d
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0, 1, 0, 0},
-        {0, 0, 0, 0, 0, 1, 0, 0},
-        {0, 0, 0, 0, 0, 1, 0, 0},
-        {0, 0, 1, 1, 1, 1, 0, 0},
-        {0, 0, 1, 0, 0, 1, 0, 0},
-        {0, 0, 1, 0, 0, 1, 0, 0},
-        {0, 0, 1, 1, 1, 1, 0, 0}
-    },
-    { // e
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 1, 1, 1, 1, 0, 0},
-        {0, 1, 1, 0, 0, 1, 1, 0},
-        {0, 1, 1, 1, 1, 1, 0, 0},
-        {0, 1, 1, 0, 0, 0, 0, 0},
-        {0, 0, 1, 1, 1, 1, 0, 0}
-    },
-    { // f
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 1, 1, 1, 0, 0},
-        {0, 0, 0, 1, 0, 1, 0, 0},
-        {0, 0, 0, 1, 0, 0, 0, 0},
-        {0, 0, 1, 1, 1, 0, 0, 0},
-        {0, 0, 0, 1, 0, 0, 0, 0},
-        {0, 0, 0, 1, 0, 0, 0, 0},
-        {0, 0, 0, 1, 0, 0, 0, 0}
-    },
-    { // g
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 1, 1, 1, 1, 0, 0},
-        {0, 1, 1, 0, 0, 1, 0, 0},
-        {0, 1, 1, 0, 0, 1, 0, 0},
-        {0, 0, 1, 1, 1, 1, 0, 0},
-        {0, 0, 0, 0, 1, 1, 0, 0},
-        {0, 1, 1, 1, 1, 0, 0, 0},
-        {0, 0, 1, 1, 0, 0, 0, 0}
-    },
-    { // h
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 1, 0, 0, 0, 0, 0},
-        {0, 0, 1, 0, 0, 0, 0, 0},
-        {0, 0, 1, 0, 0, 0, 0, 0},
-        {0, 0, 1, 0, 0, 0, 0, 0},
-        {0, 0, 1, 1, 1, 1, 0, 0},
-        {0, 0, 1, 0, 0, 1, 0, 0},
-        {0, 0, 1, 0, 0, 1, 0, 0}
-    },
-    { // i
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 1, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 1, 0, 0, 0},
-        {0, 0, 0, 0, 1, 0, 0, 0},
-        {0, 0, 0, 1, 1, 0, 0, 0},
-        {0, 0, 1, 1, 0, 1, 1, 0}
-    },
-    { // j
-        {0, 0, 0, 0, 1, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 1, 1, 0, 0},
-        {0, 0, 0, 0, 1, 0, 0, 0},
-        {0, 0, 0, 0, 1, 0, 0, 0},
-        {0, 0, 0, 0, 1, 0, 0, 0},
-        {0, 1, 1, 0, 1, 0, 0, 0},
-        {0, 0, 1, 1, 1, 0, 0, 0}
-    },
-    { // k
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 1, 0, 0, 1, 0, 0},
-        {0, 0, 1, 0, 1, 0, 0, 0},
-        {0, 0, 1, 1, 0, 0, 0, 0},
-        {0, 0, 1, 0, 1, 0, 0, 0},
-        {0, 0, 1, 0, 1, 0, 0, 0},
-        {0, 0, 1, 0, 0, 1, 0, 0}
-    },
-    { // l
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 1, 1, 0, 0, 0},
-        {0, 0, 0, 0, 1, 0, 0, 0},
-        {0, 0, 0, 0, 1, 0, 0, 0},
-        {0, 0, 0, 0, 1, 0, 0, 0},
-        {0, 0, 0, 0, 1, 0, 0, 0},
-        {0, 0, 0, 0, 1, 0, 0, 0},
-        {0, 0, 0, 1, 1, 1, 0, 0}
-    },
-    { // m
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 1, 1, 1, 1, 1, 0, 0},
-        {0, 0, 1, 1, 1, 1, 1, 0},
-        {0, 0, 1, 0, 1, 0, 1, 0},
-        {0, 0, 1, 0, 1, 0, 1, 0}
-    },
-    { // n
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 1, 1, 1, 1, 0, 0, 0},
-        {0, 0, 1, 1, 1, 1, 0, 0},
-        {0, 0, 1, 0, 0, 1, 0, 0},
-        {0, 0, 1, 0, 0, 1, 0, 0}
-    },
-    { // o
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 1, 1, 1, 1, 0, 0},
-        {0, 0, 1, 0, 0, 1, 0, 0},
-        {0, 0, 1, 0, 0, 1, 0, 0},
-        {0, 0, 1, 1, 1, 1, 0, 0}
-    },
-    { // p
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 1, 1, 1, 1, 0, 0},
-        {0, 0, 1, 0, 0, 1, 0, 0},
-        {0, 0, 1, 1, 1, 1, 0, 0},
-        {0, 0, 1, 0, 0, 0, 0, 0},
-        {0, 0, 1, 0, 0, 0, 0, 0},
-        {0, 0, 1, 0, 0, 0, 0, 0}
-    },
-    { // q
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 1, 1, 1, 1, 0, 0},
-        {0, 0, 1, 0, 0, 1, 0, 0},
-        {0, 0, 1, 1, 1, 1, 0, 0},
-        {0, 0, 0, 0, 0, 1, 0, 0},
-        {0, 0, 0, 0, 0, 1, 0, 0},
-        {0, 0, 0, 0, 0, 1, 0, 0}
-    },
-    { // r
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 1, 1, 1, 1, 1, 0},
-        {0, 0, 0, 1, 0, 1, 0, 0},
-        {0, 0, 0, 1, 0, 1, 0, 0},
-        {0, 0, 1, 0, 0, 1, 1, 0}
-    },
-    { // s
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 1, 1, 1, 1, 0, 0},
-        {0, 0, 1, 0, 0, 0, 0, 0},
-        {0, 0, 0, 1, 0, 0, 0, 0},
-        {0, 0, 0, 0, 1, 1, 0, 0},
-        {0, 0, 1, 0, 0, 1, 0, 0},
-        {0, 0, 1, 1, 1, 1, 0, 0}
-    },
-    { // t
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 1, 0, 0, 0, 0},
-        {0, 1, 1, 1, 1, 1, 0, 0},
-        {0, 0, 0, 1, 0, 0, 0, 0},
-        {0, 0, 0, 1, 0, 0, 0, 0},
-        {0, 0, 0, 1, 0, 0, 0, 0},
-        {0, 0, 0, 1, 0, 0, 0, 0},
-        {0, 0, 1, 0, 1, 0, 0, 0}
-    },
-    { // u
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 1, 0, 0, 1, 0, 0},
-        {0, 0, 1, 0, 0, 1, 0, 0},
-        {0, 0, 1, 0, 0, 1, 0, 0},
-        {0, 0, 0, 1, 1, 0, 0, 0}
-    },
-    { // v
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 1, 0, 0, 0, 0, 1, 0},
-        {0, 1, 0, 0, 0, 0, 1, 0},
-        {0, 1, 0, 0, 0, 0, 1, 0},
-        {0, 0, 1, 0, 0, 1, 0, 0},
-        {0, 0, 0, 1, 1, 0, 0, 0}
-    },
-    { // w
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {1, 0, 0, 1, 0, 0, 1, 0},
-        {1, 0, 0, 1, 0, 0, 1, 0},
-        {1, 1, 0, 1, 0, 1, 1, 0},
-        {0, 1, 1, 1, 1, 1, 0, 0}
-    },
-    { // x
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 1, 0, 0, 0, 1, 0, 0},
-        {0, 0, 1, 0, 1, 0, 0, 0},
-        {0, 0, 0, 1, 0, 0, 0, 0},
-        {0, 0, 1, 0, 1, 0, 0, 0},
-        {0, 1, 0, 0, 0, 1, 0, 0}
-    },
-    { // y
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 1, 0, 0, 1, 0, 0},
-        {0, 0, 1, 0, 0, 1, 0, 0},
-        {0, 0, 0, 1, 1, 1, 0, 0},
-        {0, 0, 0, 0, 0, 1, 0, 0},
-        {0, 0, 0, 0, 1, 1, 0, 0},
-        {0, 0, 1, 1, 1, 0, 0, 0}
-    },
-    { // z
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 1, 1, 1, 1, 1, 0},
-        {0, 0, 0, 0, 0, 1, 0, 0},
-        {0, 0, 0, 0, 1, 0, 0, 0},
-        {0, 0, 0, 1, 0, 0, 0, 0},
-        {0, 0, 1, 1, 1, 1, 1, 0}
-    }
+// Colunas vazias entre caracteres no texto proporcional
+#define PROPORTIONAL_SPACING 1
+// Largura, em colunas, de um caractere sem pixels (espaço) no texto proporcional
+#define PROPORTIONAL_BLANK_WIDTH 3
+
+typedef struct {
+    char character;
+    int frame[ROWS][COLS];
+} glyph_t;
+
+glyph_t glyphs[] = {
+    { ' ', {
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { '!', {
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { '"', {
+            {0, 1, 0, 1, 0, 0, 0, 0},
+            {0, 1, 0, 1, 0, 0, 0, 0},
+            {0, 1, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { '#', {
+            {0, 1, 0, 1, 0, 0, 0, 0},
+            {0, 1, 0, 1, 0, 0, 0, 0},
+            {1, 1, 1, 1, 1, 0, 0, 0},
+            {0, 1, 0, 1, 0, 0, 0, 0},
+            {1, 1, 1, 1, 1, 0, 0, 0},
+            {0, 1, 0, 1, 0, 0, 0, 0},
+            {0, 1, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { '$', {
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 1, 1, 1, 1, 0, 0, 0},
+            {1, 0, 1, 0, 0, 0, 0, 0},
+            {0, 1, 1, 1, 0, 0, 0, 0},
+            {0, 0, 1, 0, 1, 0, 0, 0},
+            {1, 1, 1, 1, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { '%', {
+            {1, 1, 0, 0, 0, 0, 0, 0},
+            {1, 1, 0, 0, 1, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 1, 0, 0, 0, 0, 0, 0},
+            {1, 0, 0, 1, 1, 0, 0, 0},
+            {0, 0, 0, 1, 1, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { '&', {
+            {0, 1, 1, 0, 0, 0, 0, 0},
+            {1, 0, 0, 1, 0, 0, 0, 0},
+            {1, 0, 1, 0, 0, 0, 0, 0},
+            {0, 1, 0, 0, 0, 0, 0, 0},
+            {1, 0, 1, 0, 1, 0, 0, 0},
+            {1, 0, 0, 1, 0, 0, 0, 0},
+            {0, 1, 1, 0, 1, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { '\'', {
+            {0, 1, 1, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 1, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { '(', {
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 1, 0, 0, 0, 0, 0, 0},
+            {0, 1, 0, 0, 0, 0, 0, 0},
+            {0, 1, 0, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { ')', {
+            {0, 1, 0, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 1, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { '*', {
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 1, 0, 1, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {1, 1, 1, 1, 1, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 1, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { '+', {
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {1, 1, 1, 1, 1, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { ',', {
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 1, 1, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 1, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { '-', {
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {1, 1, 1, 1, 1, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { '.', {
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 1, 1, 0, 0, 0, 0, 0},
+            {0, 1, 1, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { '/', {
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 1, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 1, 0, 0, 0, 0, 0, 0},
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { '0', {
+            {0, 1, 1, 1, 1, 1, 0, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 1, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {0, 1, 1, 1, 1, 1, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { '1', {
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 1, 1, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 1, 1, 1, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { '2', {
+            {0, 1, 1, 1, 1, 0, 0, 0},
+            {0, 0, 0, 0, 0, 1, 0, 0},
+            {0, 0, 0, 0, 0, 1, 0, 0},
+            {0, 1, 1, 1, 1, 0, 0, 0},
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {0, 1, 1, 1, 1, 1, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { '3', {
+            {1, 1, 1, 1, 1, 1, 0, 0},
+            {0, 0, 0, 0, 0, 0, 1, 0},
+            {0, 0, 0, 0, 0, 0, 1, 0},
+            {1, 1, 1, 1, 1, 1, 0, 0},
+            {0, 0, 0, 0, 0, 0, 1, 0},
+            {0, 0, 0, 0, 0, 0, 1, 0},
+            {1, 1, 1, 1, 1, 1, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { '4', {
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {1, 0, 0, 1, 0, 0, 0, 0},
+            {1, 0, 0, 1, 0, 0, 0, 0},
+            {1, 1, 1, 1, 1, 1, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { '5', {
+            {1, 1, 1, 1, 1, 0, 0, 0},
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {1, 1, 1, 1, 1, 0, 0, 0},
+            {0, 0, 0, 0, 0, 1, 0, 0},
+            {0, 0, 0, 0, 0, 1, 0, 0},
+            {1, 1, 1, 1, 1, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { '6', {
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {1, 1, 1, 1, 1, 1, 0, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {0, 1, 1, 1, 1, 1, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { '7', {
+            {1, 1, 1, 1, 1, 1, 1, 0},
+            {0, 0, 0, 0, 0, 0, 1, 0},
+            {0, 0, 0, 0, 0, 1, 0, 0},
+            {0, 0, 0, 0, 0, 1, 0, 0},
+            {0, 0, 0, 0, 1, 0, 0, 0},
+            {0, 0, 0, 1, 1, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { '8', {
+            {0, 1, 1, 1, 1, 1, 0, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {0, 1, 1, 1, 1, 1, 0, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {0, 1, 1, 1, 1, 1, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { '9', {
+            {0, 1, 1, 1, 1, 1, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {0, 1, 1, 1, 1, 1, 1, 0},
+            {0, 0, 0, 0, 0, 0, 1, 0},
+            {0, 0, 0, 0, 0, 0, 1, 0},
+            {0, 0, 0, 0, 0, 0, 1, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { ':', {
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 1, 1, 0, 0, 0, 0, 0},
+            {0, 1, 1, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 1, 1, 0, 0, 0, 0, 0},
+            {0, 1, 1, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { ';', {
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 1, 1, 0, 0, 0, 0, 0},
+            {0, 1, 1, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 1, 1, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 1, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { '<', {
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 1, 0, 0, 0, 0, 0, 0},
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {0, 1, 0, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { '=', {
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {1, 1, 1, 1, 1, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {1, 1, 1, 1, 1, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { '>', {
+            {0, 1, 0, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 0, 1, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 1, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { '?', {
+            {0, 1, 1, 1, 0, 0, 0, 0},
+            {1, 0, 0, 0, 1, 0, 0, 0},
+            {0, 0, 0, 0, 1, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { '@', {
+            {0, 1, 1, 1, 0, 0, 0, 0},
+            {1, 0, 0, 0, 1, 0, 0, 0},
+            {0, 0, 0, 0, 1, 0, 0, 0},
+            {0, 1, 1, 0, 1, 0, 0, 0},
+            {1, 0, 1, 0, 1, 0, 0, 0},
+            {1, 0, 1, 0, 1, 0, 0, 0},
+            {0, 1, 1, 1, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { 'A', {
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 1, 0, 1, 0, 0, 0},
+            {0, 1, 0, 0, 0, 1, 0, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 1, 1, 1, 1, 1, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { 'B', {
+            {1, 1, 1, 1, 1, 1, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 1, 1, 1, 1, 1, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 1, 1, 1, 1, 1, 1, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { 'C', {
+            {0, 1, 1, 1, 1, 1, 1, 0},
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {1, 1, 1, 1, 1, 1, 1, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { 'D', {
+            {1, 1, 1, 1, 1, 1, 0, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 1, 1, 1, 1, 1, 1, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { 'E', {
+            {1, 1, 1, 1, 1, 1, 1, 0},
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {1, 1, 1, 1, 1, 1, 1, 0},
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {1, 1, 1, 1, 1, 1, 1, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { 'F', {
+            {1, 1, 1, 1, 1, 1, 1, 0},
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {1, 1, 1, 1, 1, 0, 0, 0},
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { 'G', {
+            {1, 1, 1, 1, 1, 1, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {1, 0, 0, 0, 1, 1, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 1, 1, 1, 1, 1, 1, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { 'H', {
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 1, 1, 1, 1, 1, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { 'I', {
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { 'J', {
+            {1, 1, 1, 1, 1, 1, 1, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {1, 0, 0, 1, 0, 0, 0, 0},
+            {0, 1, 1, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { 'K', {
+            {0, 1, 0, 0, 0, 0, 1, 0},
+            {0, 1, 0, 0, 0, 1, 0, 0},
+            {0, 1, 0, 0, 1, 0, 0, 0},
+            {0, 1, 1, 1, 0, 0, 0, 0},
+            {0, 1, 0, 0, 1, 0, 0, 0},
+            {0, 1, 0, 0, 0, 1, 0, 0},
+            {0, 1, 0, 0, 0, 0, 1, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { 'L', {
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {1, 1, 1, 1, 1, 1, 1, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { 'M', {
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 1, 0, 0, 0, 1, 1, 0},
+            {1, 0, 1, 0, 1, 0, 1, 0},
+            {1, 0, 0, 1, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { 'N', {
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 1, 0, 0, 0, 0, 1, 0},
+            {1, 0, 1, 0, 0, 0, 1, 0},
+            {1, 0, 0, 1, 0, 0, 1, 0},
+            {1, 0, 0, 0, 1, 0, 1, 0},
+            {1, 0, 0, 0, 0, 1, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { 'O', {
+            {0, 1, 1, 1, 1, 1, 0, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {0, 1, 1, 1, 1, 1, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { 'P', {
+            {1, 1, 1, 1, 1, 1, 0, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 1, 1, 1, 1, 1, 0, 0},
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { 'Q', {
+            {0, 1, 1, 1, 1, 1, 0, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 1, 0, 0, 1, 0},
+            {1, 0, 0, 0, 1, 0, 1, 0},
+            {1, 0, 0, 0, 0, 1, 1, 0},
+            {0, 1, 1, 1, 1, 1, 1, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { 'R', {
+            {1, 1, 1, 1, 1, 1, 0, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 1, 1, 1, 1, 1, 0, 0},
+            {1, 0, 0, 0, 1, 0, 0, 0},
+            {1, 0, 0, 0, 0, 1, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { 'S', {
+            {0, 1, 1, 1, 1, 0, 0, 0},
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {0, 1, 1, 1, 1, 0, 0, 0},
+            {0, 0, 0, 0, 0, 1, 0, 0},
+            {0, 0, 0, 0, 0, 1, 0, 0},
+            {1, 1, 1, 1, 1, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { 'T', {
+            {1, 1, 1, 1, 1, 1, 1, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { 'U', {
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {0, 1, 1, 1, 1, 1, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { 'V', {
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {0, 1, 0, 0, 0, 1, 0, 0},
+            {0, 0, 1, 0, 1, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { 'W', {
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {1, 0, 0, 1, 0, 0, 1, 0},
+            {1, 0, 1, 0, 1, 0, 1, 0},
+            {1, 1, 0, 0, 0, 1, 1, 0},
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { 'X', {
+            {0, 1, 0, 0, 0, 0, 1, 0},
+            {0, 0, 1, 0, 0, 1, 0, 0},
+            {0, 0, 0, 1, 1, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 1, 1, 0, 0, 0},
+            {0, 0, 1, 0, 0, 1, 0, 0},
+            {0, 1, 0, 0, 0, 0, 1, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { 'Y', {
+            {1, 0, 0, 0, 0, 0, 1, 0},
+            {0, 1, 0, 0, 0, 1, 0, 0},
+            {0, 0, 1, 0, 1, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { 'Z', {
+            {1, 1, 1, 1, 1, 1, 0, 0},
+            {0, 0, 0, 0, 1, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 1, 0, 0, 0, 0, 0, 0},
+            {1, 1, 1, 1, 1, 1, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { '[', {
+            {0, 1, 1, 1, 0, 0, 0, 0},
+            {0, 1, 0, 0, 0, 0, 0, 0},
+            {0, 1, 0, 0, 0, 0, 0, 0},
+            {0, 1, 0, 0, 0, 0, 0, 0},
+            {0, 1, 0, 0, 0, 0, 0, 0},
+            {0, 1, 0, 0, 0, 0, 0, 0},
+            {0, 1, 1, 1, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { '\\', {
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {1, 0, 0, 0, 0, 0, 0, 0},
+            {0, 1, 0, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 0, 1, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { ']', {
+            {0, 1, 1, 1, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 1, 1, 1, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { '^', {
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 1, 0, 1, 0, 0, 0, 0},
+            {1, 0, 0, 0, 1, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { '_', {
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {1, 1, 1, 1, 1, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { '`', {
+            {0, 1, 0, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { 'a', {
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 1, 1, 1, 1, 0, 0},
+            {0, 1, 1, 0, 0, 1, 1, 0},
+            {0, 1, 0, 0, 0, 0, 1, 0},
+            {0, 1, 1, 0, 0, 1, 1, 0},
+            {1, 0, 1, 1, 1, 1, 0, 1}
+    }},
+    { 'b', {
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 1, 1, 1, 1, 0, 0},
+            {0, 0, 1, 0, 0, 1, 0, 0},
+            {0, 0, 1, 0, 0, 1, 0, 0},
+            {0, 0, 1, 1, 1, 1, 0, 0}
+    }},
+    { 'c', {
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 1, 1, 1, 1, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 1, 1, 1, 1, 0, 0}
+    }},
+    { 'd', {
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 1, 0, 0},
+            {0, 0, 0, 0, 0, 1, 0, 0},
+            {0, 0, 0, 0, 0, 1, 0, 0},
+            {0, 0, 1, 1, 1, 1, 0, 0},
+            {0, 0, 1, 0, 0, 1, 0, 0},
+            {0, 0, 1, 0, 0, 1, 0, 0},
+            {0, 0, 1, 1, 1, 1, 0, 0}
+    }},
+    { 'e', {
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 1, 1, 1, 1, 0, 0},
+            {0, 1, 1, 0, 0, 1, 1, 0},
+            {0, 1, 1, 1, 1, 1, 0, 0},
+            {0, 1, 1, 0, 0, 0, 0, 0},
+            {0, 0, 1, 1, 1, 1, 0, 0}
+    }},
+    { 'f', {
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 1, 1, 1, 0, 0},
+            {0, 0, 0, 1, 0, 1, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 1, 1, 1, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0}
+    }},
+    { 'g', {
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 1, 1, 1, 1, 0, 0},
+            {0, 1, 1, 0, 0, 1, 0, 0},
+            {0, 1, 1, 0, 0, 1, 0, 0},
+            {0, 0, 1, 1, 1, 1, 0, 0},
+            {0, 0, 0, 0, 1, 1, 0, 0},
+            {0, 1, 1, 1, 1, 0, 0, 0},
+            {0, 0, 1, 1, 0, 0, 0, 0}
+    }},
+    { 'h', {
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 1, 1, 1, 1, 0, 0},
+            {0, 0, 1, 0, 0, 1, 0, 0},
+            {0, 0, 1, 0, 0, 1, 0, 0}
+    }},
+    { 'i', {
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 1, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 1, 0, 0, 0},
+            {0, 0, 0, 0, 1, 0, 0, 0},
+            {0, 0, 0, 1, 1, 0, 0, 0},
+            {0, 0, 1, 1, 0, 1, 1, 0}
+    }},
+    { 'j', {
+            {0, 0, 0, 0, 1, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 1, 1, 0, 0},
+            {0, 0, 0, 0, 1, 0, 0, 0},
+            {0, 0, 0, 0, 1, 0, 0, 0},
+            {0, 0, 0, 0, 1, 0, 0, 0},
+            {0, 1, 1, 0, 1, 0, 0, 0},
+            {0, 0, 1, 1, 1, 0, 0, 0}
+    }},
+    { 'k', {
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 1, 0, 0},
+            {0, 0, 1, 0, 1, 0, 0, 0},
+            {0, 0, 1, 1, 0, 0, 0, 0},
+            {0, 0, 1, 0, 1, 0, 0, 0},
+            {0, 0, 1, 0, 1, 0, 0, 0},
+            {0, 0, 1, 0, 0, 1, 0, 0}
+    }},
+    { 'l', {
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 1, 1, 0, 0, 0},
+            {0, 0, 0, 0, 1, 0, 0, 0},
+            {0, 0, 0, 0, 1, 0, 0, 0},
+            {0, 0, 0, 0, 1, 0, 0, 0},
+            {0, 0, 0, 0, 1, 0, 0, 0},
+            {0, 0, 0, 0, 1, 0, 0, 0},
+            {0, 0, 0, 1, 1, 1, 0, 0}
+    }},
+    { 'm', {
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 1, 1, 1, 1, 1, 0, 0},
+            {0, 0, 1, 1, 1, 1, 1, 0},
+            {0, 0, 1, 0, 1, 0, 1, 0},
+            {0, 0, 1, 0, 1, 0, 1, 0}
+    }},
+    { 'n', {
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 1, 1, 1, 1, 0, 0, 0},
+            {0, 0, 1, 1, 1, 1, 0, 0},
+            {0, 0, 1, 0, 0, 1, 0, 0},
+            {0, 0, 1, 0, 0, 1, 0, 0}
+    }},
+    { 'o', {
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 1, 1, 1, 1, 0, 0},
+            {0, 0, 1, 0, 0, 1, 0, 0},
+            {0, 0, 1, 0, 0, 1, 0, 0},
+            {0, 0, 1, 1, 1, 1, 0, 0}
+    }},
+    { 'p', {
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 1, 1, 1, 1, 0, 0},
+            {0, 0, 1, 0, 0, 1, 0, 0},
+            {0, 0, 1, 1, 1, 1, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0}
+    }},
+    { 'q', {
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 1, 1, 1, 1, 0, 0},
+            {0, 0, 1, 0, 0, 1, 0, 0},
+            {0, 0, 1, 1, 1, 1, 0, 0},
+            {0, 0, 0, 0, 0, 1, 0, 0},
+            {0, 0, 0, 0, 0, 1, 0, 0},
+            {0, 0, 0, 0, 0, 1, 0, 0}
+    }},
+    { 'r', {
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 1, 1, 1, 1, 1, 0},
+            {0, 0, 0, 1, 0, 1, 0, 0},
+            {0, 0, 0, 1, 0, 1, 0, 0},
+            {0, 0, 1, 0, 0, 1, 1, 0}
+    }},
+    { 's', {
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 1, 1, 1, 1, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 0, 1, 1, 0, 0},
+            {0, 0, 1, 0, 0, 1, 0, 0},
+            {0, 0, 1, 1, 1, 1, 0, 0}
+    }},
+    { 't', {
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 1, 1, 1, 1, 1, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 1, 0, 1, 0, 0, 0}
+    }},
+    { 'u', {
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 1, 0, 0},
+            {0, 0, 1, 0, 0, 1, 0, 0},
+            {0, 0, 1, 0, 0, 1, 0, 0},
+            {0, 0, 0, 1, 1, 0, 0, 0}
+    }},
+    { 'v', {
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 1, 0, 0, 0, 0, 1, 0},
+            {0, 1, 0, 0, 0, 0, 1, 0},
+            {0, 1, 0, 0, 0, 0, 1, 0},
+            {0, 0, 1, 0, 0, 1, 0, 0},
+            {0, 0, 0, 1, 1, 0, 0, 0}
+    }},
+    { 'w', {
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {1, 0, 0, 1, 0, 0, 1, 0},
+            {1, 0, 0, 1, 0, 0, 1, 0},
+            {1, 1, 0, 1, 0, 1, 1, 0},
+            {0, 1, 1, 1, 1, 1, 0, 0}
+    }},
+    { 'x', {
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 1, 0, 0, 0, 1, 0, 0},
+            {0, 0, 1, 0, 1, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 1, 0, 1, 0, 0, 0},
+            {0, 1, 0, 0, 0, 1, 0, 0}
+    }},
+    { 'y', {
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 1, 0, 0},
+            {0, 0, 1, 0, 0, 1, 0, 0},
+            {0, 0, 0, 1, 1, 1, 0, 0},
+            {0, 0, 0, 0, 0, 1, 0, 0},
+            {0, 0, 0, 0, 1, 1, 0, 0},
+            {0, 0, 1, 1, 1, 0, 0, 0}
+    }},
+    { 'z', {
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 1, 1, 1, 1, 1, 0},
+            {0, 0, 0, 0, 0, 1, 0, 0},
+            {0, 0, 0, 0, 1, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 1, 1, 1, 1, 1, 0}
+    }},
+    { '{', {
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 1, 0, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { '|', {
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { '}', {
+            {0, 1, 0, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0, 0, 0},
+            {0, 1, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }},
+    { '~', {
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 1, 0, 0, 0, 0, 0, 0},
+            {1, 0, 1, 0, 1, 0, 0, 0},
+            {0, 0, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0, 0, 0}
+    }}
 };
 
-void convert_frame_to_hex(int frames[][ROWS][COLS], int num_frames) {
-    for (int f = 0; f < num_frames; f++) {
-        unsigned char hex_values[COLS];
-        for (int j = 0; j < COLS; j++) {
-            unsigned char value = 0;
-            for (int i = 0; i < ROWS; i++) {
-                // Invertendo as linhas
-                value = (value << 1) | frames[f][ROWS - 1 - i][j]; 
-            }
-            hex_values[j] = value;
+#define NUM_GLYPHS ((int)(sizeof(glyphs) / sizeof(glyphs[0])))
+
+// Converte uma matriz em 8 bytes, um por coluna, com a linha de cima no bit 0
+void convert_frame_to_columns(int frame[ROWS][COLS], unsigned char columns[COLS]) {
+    for (int j = 0; j < COLS; j++) {
+        unsigned char value = 0;
+        for (int i = 0; i < ROWS; i++) {
+            // Invertendo as linhas
+            value = (value << 1) | frame[ROWS - 1 - i][j];
         }
+        columns[j] = value;
+    }
+}
 
+int compare_glyphs(const void *a, const void *b) {
+    return ((const glyph_t *)a)->character - ((const glyph_t *)b)->character;
+}
+
+void print_character_comment(FILE *out, char c) {
+    if (c == ' ') {
+        fprintf(out, "espaço");
+    } else if (c == '\\') {
+        fprintf(out, "barra invertida");
+    } else {
+        fprintf(out, "%c", c);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    int proportional = 0;
+    const char *output_path = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-p") == 0) {
+            proportional = 1;
+        } else {
+            output_path = argv[i];
+        }
+    }
+    if (output_path == NULL) {
+        fprintf(stderr, "uso: %s [-p] <saída>\n", argv[0]);
+        return 1;
+    }
+
+    // Ordena os caracteres para que o mapa de índices seja contínuo
+    qsort(glyphs, NUM_GLYPHS, sizeof(glyph_t), compare_glyphs);
+    for (int g = 1; g < NUM_GLYPHS; g++) {
+        if (glyphs[g].character == glyphs[g - 1].character) {
+            fprintf(stderr, "caractere '%c' definido duas vezes\n", glyphs[g].character);
+            return 1;
+        }
+    }
+    int first = glyphs[0].character;
+    int last = glyphs[NUM_GLYPHS - 1].character;
+
+    // Caracteres ausentes dentro do intervalo usam o espaço, se houver
+    int fallback = 0;
+    for (int g = 0; g < NUM_GLYPHS; g++) {
+        if (glyphs[g].character == ' ') fallback = g;
+    }
+
+    FILE *out = fopen(output_path, "w");
+    if (out == NULL) {
+        perror(output_path);
+        return 1;
+    }
+
+    fprintf(out, "// Gerado por display/make_font.c durante a compilação. Não edite.\n");
+    fprintf(out, "#ifndef FONT_H\n#define FONT_H\n\n#include <stdint.h>\n\n");
+    fprintf(out, "#define FONT_FIRST_CHAR 0x%02X\n", first);
+    fprintf(out, "#define FONT_LAST_CHAR 0x%02X\n", last);
+    fprintf(out, "#define FONT_GLYPH_WIDTH %d\n", COLS);
+    fprintf(out, "#define FONT_GLYPH_COUNT %d\n\n", NUM_GLYPHS);
+
+    // Mapa caractere -> glifo, indexado por (c - FONT_FIRST_CHAR)
+    fprintf(out, "static const uint8_t font_index[] = {");
+    for (int c = first, g = 0; c <= last; c++) {
+        int index = fallback;
+        if (glyphs[g].character == c) index = g++;
+        fprintf(out, "%s%s%3d", c == first ? "" : ",", (c - first) % 16 ? " " : "\n    ", index);
+    }
+    fprintf(out, "\n};\n\n");
+
+    // Glifos: 8 bytes por caractere, um por coluna, com a linha de cima no bit 0
+    unsigned char columns[NUM_GLYPHS][COLS];
+    fprintf(out, "static const uint8_t font[] = {\n");
+    for (int g = 0; g < NUM_GLYPHS; g++) {
+        convert_frame_to_columns(glyphs[g].frame, columns[g]);
+        fprintf(out, "    ");
         for (int j = 0; j < COLS; j++) {
-            if (j == COLS - 1) {
-                printf("0x%02X,\n", hex_values[j]);
-            } else {
-                printf("0x%02X, ", hex_values[j]);
-            }
+            fprintf(out, "0x%02X%s", columns[g][j], g == NUM_GLYPHS - 1 && j == COLS - 1 ? " " : ", ");
         }
+        fprintf(out, "// ");
+        print_character_comment(out, glyphs[g].character);
+        fprintf(out, "\n");
     }
-}
+    fprintf(out, "};\n");
 
-int main() {
-    int num_frames = sizeof(frames) / sizeof(frames[0]);
-    convert_frame_to_hex(frames, num_frames);
+    if (proportional) {
+        // Primeira coluna com pixels e número de colunas ocupadas de cada glifo
+        fprintf(out, "\n#define FONT_PROPORTIONAL 1\n");
+        fprintf(out, "#define FONT_SPACING %d\n", PROPORTIONAL_SPACING);
+        fprintf(out, "#define FONT_BLANK_WIDTH %d\n\n", PROPORTIONAL_BLANK_WIDTH);
+        fprintf(out, "static const uint8_t font_offset[] = {");
+        for (int g = 0; g < NUM_GLYPHS; g++) {
+            int offset = 0;
+            while (offset < COLS && !columns[g][offset]) offset++;
+            fprintf(out, "%s%s%d", g ? "," : "", g % 16 ? " " : "\n    ", offset % COLS);
+        }
+        fprintf(out, "\n};\n\n");
+        fprintf(out, "static const uint8_t font_width[] = {");
+        for (int g = 0; g < NUM_GLYPHS; g++) {
+            int offset = 0, end = COLS;
+            while (offset < COLS && !columns[g][offset]) offset++;
+            while (end > offset && !columns[g][end - 1]) end--;
+            fprintf(out, "%s%s%d", g ? "," : "", g % 16 ? " " : "\n    ", end - offset);
+        }
+        fprintf(out, "\n};\n");
+    }
 
+    fprintf(out, "\n#endif\n");
+    fclose(out);
     return 0;
 }
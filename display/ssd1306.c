@@ -1,5 +1,16 @@
 #include "ssd1306.h"
 #include "font.h"
+#include <stdio.h>
+#include <string.h>
+
+// Custo fixo, em bytes no barramento, de abrir uma nova janela de envio:
+// endereço I2C, 6 comandos de endereçamento com seus bytes de controle e
+// o byte de controle dos dados
+#define SSD1306_WINDOW_OVERHEAD (1 + 6 * 2 + 1)
+
+// Bytes que precedem os dados de uma janela: 6 comandos de endereçamento
+// (controle + comando) e o byte de controle dos dados
+#define SSD1306_WINDOW_HEADER (6 * 2 + 1)
 
 void ssd1306_init(ssd1306_t *ssd, 
   uint8_t width, uint8_t height, 
@@ -10,91 +21,419 @@ void ssd1306_init(ssd1306_t *ssd,
   ssd->pages = height / 8U;
   ssd->address = address;
   ssd->i2c_port = i2c;
-  ssd->bufsize = ssd->pages * ssd->width + 1;
+  ssd->external_vcc = external_vcc;
+  // Buffer organizado por páginas: índice = página * largura + coluna
+  ssd->bufsize = ssd->pages * ssd->width;
   ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
-  ssd->ram_buffer[0] = 0x40;
+  ssd->tx_buffer = calloc(SSD1306_WINDOW_HEADER + ssd->bufsize, sizeof(uint8_t));
+  ssd->batch_length = 0;
   ssd->port_buffer[0] = 0x80;
+  ssd->flush_bytes = 0;
+  ssd->total_bytes = 0;
+  ssd->dirty_pages = 0;
+  ssd->dma_channel = -1;
+  ssd->in_flight = false;
+  ssd->flush_cb = NULL;
+  ssd->start_line = 0;
+  ssd->start_line_dirty = false;
+  ssd->bus_errors = 0;
+  ssd->bus_hz = 0;
+  ssd->bus_bytes_per_second = 0;
+  // O primeiro envio precisa transmitir a tela inteira
+  ssd1306_mark_dirty(ssd, 0, ssd->width - 1, 0, ssd->pages - 1);
 }
 
 void ssd1306_config(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_DISP | 0x00);
-  ssd1306_command(ssd, SET_MEM_ADDR);
-  ssd1306_command(ssd, 0x01);
-  ssd1306_command(ssd, SET_DISP_START_LINE | 0x00);
-  ssd1306_command(ssd, SET_SEG_REMAP | 0x01);
-  ssd1306_command(ssd, SET_MUX_RATIO);
-  ssd1306_command(ssd, HEIGHT - 1);
-  ssd1306_command(ssd, SET_COM_OUT_DIR | 0x08);
-  ssd1306_command(ssd, SET_DISP_OFFSET);
-  ssd1306_command(ssd, 0x00);
-  ssd1306_command(ssd, SET_COM_PIN_CFG);
-  ssd1306_command(ssd, 0x12);
-  ssd1306_command(ssd, SET_DISP_CLK_DIV);
-  ssd1306_command(ssd, 0x80);
-  ssd1306_command(ssd, SET_PRECHARGE);
-  ssd1306_command(ssd, 0xF1);
-  ssd1306_command(ssd, SET_VCOM_DESEL);
-  ssd1306_command(ssd, 0x30);
-  ssd1306_command(ssd, SET_CONTRAST);
-  ssd1306_command(ssd, 0xFF);
-  ssd1306_command(ssd, SET_ENTIRE_ON);
-  ssd1306_command(ssd, SET_NORM_INV);
-  ssd1306_command(ssd, SET_CHARGE_PUMP);
-  ssd1306_command(ssd, 0x14);
-  ssd1306_command(ssd, SET_DISP | 0x01);
+  // Toda a inicialização vai em uma única transação I2C
+  ssd1306_batch_command(ssd, SET_DISP | 0x00);
+  ssd1306_batch_command(ssd, SET_MEM_ADDR);
+  // Endereçamento horizontal: cada página é percorrida coluna a coluna
+  ssd1306_batch_command(ssd, 0x00);
+  ssd1306_batch_command(ssd, SET_DISP_START_LINE | 0x00);
+  ssd1306_batch_command(ssd, SET_SEG_REMAP | 0x01);
+  ssd1306_batch_command(ssd, SET_MUX_RATIO);
+  ssd1306_batch_command(ssd, HEIGHT - 1);
+  ssd1306_batch_command(ssd, SET_COM_OUT_DIR | 0x08);
+  ssd1306_batch_command(ssd, SET_DISP_OFFSET);
+  ssd1306_batch_command(ssd, 0x00);
+  ssd1306_batch_command(ssd, SET_COM_PIN_CFG);
+  ssd1306_batch_command(ssd, 0x12);
+  ssd1306_batch_command(ssd, SET_DISP_CLK_DIV);
+  ssd1306_batch_command(ssd, 0x80);
+  ssd1306_batch_command(ssd, SET_PRECHARGE);
+  ssd1306_batch_command(ssd, 0xF1);
+  ssd1306_batch_command(ssd, SET_VCOM_DESEL);
+  ssd1306_batch_command(ssd, 0x30);
+  ssd1306_batch_command(ssd, SET_CONTRAST);
+  ssd1306_batch_command(ssd, 0xFF);
+  ssd1306_batch_command(ssd, SET_ENTIRE_ON);
+  ssd1306_batch_command(ssd, SET_NORM_INV);
+  ssd1306_batch_command(ssd, SET_CHARGE_PUMP);
+  ssd1306_batch_command(ssd, 0x14);
+  ssd1306_batch_command(ssd, SET_DISP | 0x01);
+  ssd1306_batch_send(ssd);
 }
 
-void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
-  ssd->port_buffer[1] = command;
-  i2c_write_blocking(
+static void ssd1306_write(ssd1306_t *ssd, const uint8_t *data, size_t len) {
+  int written = i2c_write_blocking(
     ssd->i2c_port,
     ssd->address,
-    ssd->port_buffer,
-    2,
+    data,
+    len,
     false
   );
+  if (written > 0) {
+    ssd->flush_bytes += written;
+    ssd->total_bytes += written;
+  }
+  // Byte sem ACK ou escrita incompleta
+  if (written != (int)len) {
+    ssd->bus_errors++;
+  }
+}
+
+void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
+  ssd1306_wait(ssd);
+  ssd->port_buffer[1] = command;
+  ssd1306_write(ssd, ssd->port_buffer, 2);
+}
+
+void ssd1306_batch_command(ssd1306_t *ssd, uint8_t command) {
+  if (ssd->batch_length == SSD1306_BATCH_SIZE) {
+    ssd1306_batch_send(ssd);
+  }
+  ssd->batch[1 + ssd->batch_length++] = command;
+}
+
+void ssd1306_batch_send(ssd1306_t *ssd) {
+  if (!ssd->batch_length) return;
+  ssd1306_wait(ssd);
+  // Byte de controle 0x00 (Co = 0, D/C = 0): todos os bytes seguintes
+  // da transação são comandos
+  ssd->batch[0] = 0x00;
+  ssd1306_write(ssd, ssd->batch, ssd->batch_length + 1);
+  ssd->batch_length = 0;
+}
+
+void ssd1306_commands(ssd1306_t *ssd, const uint8_t *commands, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    ssd1306_batch_command(ssd, commands[i]);
+  }
+  ssd1306_batch_send(ssd);
+}
+
+void ssd1306_mark_dirty(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t page0, uint8_t page1) {
+  for (uint8_t page = page0; page <= page1; ++page) {
+    uint8_t mask = 1 << page;
+    if (!(ssd->dirty_pages & mask)) {
+      ssd->dirty_pages |= mask;
+      ssd->dirty_x0[page] = x0;
+      ssd->dirty_x1[page] = x1;
+    } else {
+      if (x0 < ssd->dirty_x0[page]) ssd->dirty_x0[page] = x0;
+      if (x1 > ssd->dirty_x1[page]) ssd->dirty_x1[page] = x1;
+    }
+  }
+}
+
+// Escreve em out o cabeçalho de uma janela: os comandos de endereçamento,
+// cada um precedido do controle 0x80 (Co = 1, um comando), seguidos do
+// controle 0x40 (Co = 0, D/C = 1) que inicia os dados na mesma transação
+static void ssd1306_window_header(uint8_t *out, 
+  uint8_t x0, uint8_t x1, uint8_t page0, uint8_t page1
+) {
+  const uint8_t commands[] = {
+    SET_COL_ADDR, x0, x1,
+    SET_PAGE_ADDR, page0, page1
+  };
+  for (uint8_t i = 0; i < sizeof(commands); ++i) {
+    *out++ = 0x80;
+    *out++ = commands[i];
+  }
+  *out = 0x40;
+}
+
+typedef void (*ssd1306_window_fn)(ssd1306_t *ssd, 
+  uint8_t x0, uint8_t x1, uint8_t page0, uint8_t page1
+);
+
+// Envia as colunas x0..x1 das páginas page0..page1, com o endereçamento
+// e os dados em uma só transação
+static void ssd1306_send_window(ssd1306_t *ssd, 
+  uint8_t x0, uint8_t x1, uint8_t page0, uint8_t page1
+) {
+  ssd1306_window_header(ssd->tx_buffer, x0, x1, page0, page1);
+
+  // Copia as linhas de página para o buffer de transmissão, na ordem
+  // em que o controlador as percorre no endereçamento horizontal
+  uint8_t span = x1 - x0 + 1;
+  uint8_t *out = ssd->tx_buffer + SSD1306_WINDOW_HEADER;
+  for (uint8_t page = page0; page <= page1; ++page) {
+    memcpy(out, &ssd->ram_buffer[page * ssd->width + x0], span);
+    out += span;
+  }
+  ssd1306_write(ssd, ssd->tx_buffer, out - ssd->tx_buffer);
+}
+
+// Mesma janela de ssd1306_send_window, mas montada no buffer frontal
+static void ssd1306_queue_window(ssd1306_t *ssd, 
+  uint8_t x0, uint8_t x1, uint8_t page0, uint8_t page1
+) {
+  uint8_t header[SSD1306_WINDOW_HEADER];
+  ssd1306_window_header(header, x0, x1, page0, page1);
+
+  uint16_t *out = ssd->front_buffer + ssd->front_length;
+  for (uint8_t i = 0; i < SSD1306_WINDOW_HEADER; ++i) {
+    *out++ = header[i];
+  }
+  uint8_t span = x1 - x0 + 1;
+  for (uint8_t page = page0; page <= page1; ++page) {
+    const uint8_t *row = &ssd->ram_buffer[page * ssd->width + x0];
+    for (uint8_t i = 0; i < span; ++i) {
+      *out++ = row[i];
+    }
+  }
+  // O último byte encerra a transação com STOP
+  out[-1] |= I2C_IC_DATA_CMD_STOP_BITS;
+  ssd->front_length = out - ssd->front_buffer;
+}
+
+// Percorre as páginas sujas, agrupando páginas consecutivas em uma só
+// janela sempre que a união das colunas custa menos do que abrir uma
+// janela separada, e limpa a região suja
+static void ssd1306_flush_windows(ssd1306_t *ssd, ssd1306_window_fn emit) {
+  int8_t run_page0 = -1;
+  uint8_t run_page1 = 0, run_x0 = 0, run_x1 = 0;
+  for (uint8_t page = 0; page < ssd->pages; ++page) {
+    if (!(ssd->dirty_pages & (1 << page))) continue;
+    uint8_t x0 = ssd->dirty_x0[page];
+    uint8_t x1 = ssd->dirty_x1[page];
+
+    if (run_page0 >= 0 && page == run_page1 + 1) {
+      uint8_t merged_x0 = x0 < run_x0 ? x0 : run_x0;
+      uint8_t merged_x1 = x1 > run_x1 ? x1 : run_x1;
+      uint16_t rows = page - run_page0 + 1;
+      uint16_t merged = (merged_x1 - merged_x0 + 1) * rows;
+      uint16_t separate = (run_x1 - run_x0 + 1) * (rows - 1) 
+        + (x1 - x0 + 1) + SSD1306_WINDOW_OVERHEAD;
+      if (merged <= separate) {
+        run_x0 = merged_x0;
+        run_x1 = merged_x1;
+        run_page1 = page;
+        continue;
+      }
+    }
+
+    if (run_page0 >= 0) {
+      emit(ssd, run_x0, run_x1, run_page0, run_page1);
+    }
+    run_page0 = page;
+    run_page1 = page;
+    run_x0 = x0;
+    run_x1 = x1;
+  }
+  if (run_page0 >= 0) {
+    emit(ssd, run_x0, run_x1, run_page0, run_page1);
+  }
+
+  ssd->dirty_pages = 0;
 }
 
 void ssd1306_send_data(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_COL_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->width - 1);
-  ssd1306_command(ssd, SET_PAGE_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->pages - 1);
-  i2c_write_blocking(
-    ssd->i2c_port,
-    ssd->address,
-    ssd->ram_buffer,
-    ssd->bufsize,
+  // Não pode disputar o barramento com um envio assíncrono em andamento
+  ssd1306_wait(ssd);
+  ssd->flush_bytes = 0;
+  ssd1306_flush_windows(ssd, ssd1306_send_window);
+  // A linha inicial muda depois dos dados, para que a nova linha já
+  // esteja na GDDRAM quando aparecer
+  if (ssd->start_line_dirty) {
+    ssd1306_command(ssd, SET_DISP_START_LINE | ssd->start_line);
+    ssd->start_line_dirty = false;
+  }
+}
+
+bool ssd1306_pending(ssd1306_t *ssd) {
+  return ssd->dirty_pages || ssd->start_line_dirty;
+}
+
+void ssd1306_set_start_line(ssd1306_t *ssd, uint8_t line) {
+  ssd->start_line = line % ssd->height;
+  ssd->start_line_dirty = true;
+}
+
+void ssd1306_dma_init(ssd1306_t *ssd) {
+  // Pior caso: todas as páginas em janelas separadas cobrindo a tela toda
+  // e a troca da linha inicial (controle + comando)
+  ssd->front_capacity = ssd->bufsize + ssd->pages * SSD1306_WINDOW_HEADER + 2;
+  ssd->front_buffer = calloc(ssd->front_capacity, sizeof(uint16_t));
+  ssd->front_length = 0;
+  ssd->in_flight = false;
+
+  ssd->dma_channel = dma_claim_unused_channel(true);
+  dma_channel_config config = dma_channel_get_default_config(ssd->dma_channel);
+  // Cada palavra é escrita no registrador DATA_CMD: byte + bit de STOP
+  channel_config_set_transfer_data_size(&config, DMA_SIZE_16);
+  channel_config_set_read_increment(&config, true);
+  channel_config_set_write_increment(&config, false);
+  // O DMA avança conforme a FIFO de transmissão do I2C tem espaço
+  channel_config_set_dreq(&config, i2c_get_dreq(ssd->i2c_port, true));
+  dma_channel_configure(
+    ssd->dma_channel,
+    &config,
+    &i2c_get_hw(ssd->i2c_port)->data_cmd,
+    ssd->front_buffer,
+    0,
     false
   );
 }
 
+bool ssd1306_send_data_async(ssd1306_t *ssd) {
+  // O envio anterior ainda está no barramento: a região suja continua
+  // acumulando e será enviada no próximo pedido
+  if (!ssd1306_poll(ssd)) return false;
+  if (!ssd1306_pending(ssd)) return true;
+
+  // Copia a região suja para o buffer frontal; a partir daqui o
+  // ram_buffer pode voltar a ser desenhado sem afetar o envio
+  ssd->front_length = 0;
+  ssd1306_flush_windows(ssd, ssd1306_queue_window);
+  if (ssd->start_line_dirty) {
+    ssd->front_buffer[ssd->front_length++] = 0x80;
+    ssd->front_buffer[ssd->front_length++] = 
+      (SET_DISP_START_LINE | ssd->start_line) | I2C_IC_DATA_CMD_STOP_BITS;
+    ssd->start_line_dirty = false;
+  }
+  ssd->flush_bytes = ssd->front_length;
+  ssd->total_bytes += ssd->front_length;
+
+  i2c_hw_t *hw = i2c_get_hw(ssd->i2c_port);
+  hw->enable = 0;
+  hw->tar = ssd->address;
+  hw->enable = 1;
+  hw->dma_cr = I2C_IC_DMA_CR_TDMAE_BITS;
+
+  ssd->in_flight = true;
+  dma_channel_transfer_from_buffer_now(
+    ssd->dma_channel, ssd->front_buffer, ssd->front_length
+  );
+  return true;
+}
+
+bool ssd1306_poll(ssd1306_t *ssd) {
+  if (!ssd->in_flight) return true;
+
+  i2c_hw_t *hw = i2c_get_hw(ssd->i2c_port);
+  bool ok = true;
+  if (hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS) {
+    // O display não confirmou algum byte: o controlador I2C descarta a
+    // FIFO, então o quadro inteiro precisa ser reenviado
+    dma_channel_abort(ssd->dma_channel);
+    (void)hw->clr_tx_abrt;
+    ssd1306_mark_dirty(ssd, 0, ssd->width - 1, 0, ssd->pages - 1);
+    ssd->bus_errors++;
+    ok = false;
+  } else if (dma_channel_is_busy(ssd->dma_channel) ||
+             !(hw->status & I2C_IC_STATUS_TFE_BITS) ||
+             (hw->status & I2C_IC_STATUS_ACTIVITY_BITS)) {
+    // Ainda há palavras no DMA, na FIFO ou no barramento
+    return false;
+  }
+
+  hw->dma_cr = 0;
+  ssd->in_flight = false;
+  if (ssd->flush_cb) ssd->flush_cb(ssd, ok);
+  return true;
+}
+
+void ssd1306_wait(ssd1306_t *ssd) {
+  while (!ssd1306_poll(ssd)) {
+    tight_loop_contents();
+  }
+}
+
+void ssd1306_set_flush_callback(ssd1306_t *ssd, ssd1306_flush_cb_t cb) {
+  ssd->flush_cb = cb;
+}
+
+bool ssd1306_bus_test(ssd1306_t *ssd, uint8_t frames) {
+  ssd1306_wait(ssd);
+  uint32_t errors = ssd->bus_errors;
+  uint32_t bytes = 0;
+
+  // Reenvia o conteúdo atual da tela: o teste não muda o que é exibido
+  uint64_t start = time_us_64();
+  for (uint8_t i = 0; i < frames; ++i) {
+    ssd1306_mark_dirty(ssd, 0, ssd->width - 1, 0, ssd->pages - 1);
+    ssd1306_send_data(ssd);
+    bytes += ssd->flush_bytes;
+  }
+  uint64_t elapsed = time_us_64() - start;
+
+  ssd->bus_bytes_per_second = elapsed ? (uint32_t)(bytes * 1000000ull / elapsed) : 0;
+  return ssd->bus_errors == errors;
+}
+
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
-  uint16_t index = (y >> 3) + (x << 3) + 1;
+  if (x >= ssd->width || y >= ssd->height) return;
+  uint8_t page = y >> 3;
+  uint16_t index = page * ssd->width + x;
   uint8_t pixel = (y & 0b111);
   if (value)
     ssd->ram_buffer[index] |= (1 << pixel);
   else
     ssd->ram_buffer[index] &= ~(1 << pixel);
+  ssd1306_mark_dirty(ssd, x, x, page, page);
 }
 
-/*
-void ssd1306_fill(ssd1306_t *ssd, bool value) {
-  uint8_t byte = value ? 0xFF : 0x00;
-  for (uint8_t i = 1; i < ssd->bufsize; ++i)
-    ssd->ram_buffer[i] = byte;
+// Recorta o retângulo x0..x1, y0..y1 (inclusivo) aos limites do display.
+// Retorna false se nada dele fica visível
+static bool ssd1306_clip(ssd1306_t *ssd, int *x0, int *y0, int *x1, int *y1) {
+  if (*x0 > *x1 || *y0 > *y1) return false;
+  if (*x1 < 0 || *y1 < 0 || *x0 >= ssd->width || *y0 >= ssd->height) return false;
+  if (*x0 < 0) *x0 = 0;
+  if (*y0 < 0) *y0 = 0;
+  if (*x1 >= ssd->width) *x1 = ssd->width - 1;
+  if (*y1 >= ssd->height) *y1 = ssd->height - 1;
+  return true;
 }
-*/
 
-void ssd1306_fill(ssd1306_t *ssd, bool value) {
-    // Itera por todas as posições do display
-    for (uint8_t y = 0; y < ssd->height; ++y) {
-        for (uint8_t x = 0; x < ssd->width; ++x) {
-            ssd1306_pixel(ssd, x, y, value);
-        }
+// Preenche a área x0..x1, y0..y1, já recortada, página por página: cada
+// página recebe a máscara dos seus bits cobertos em toda a faixa de colunas
+static void ssd1306_fill_area(ssd1306_t *ssd, 
+  uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value
+) {
+  uint8_t page0 = y0 >> 3;
+  uint8_t page1 = y1 >> 3;
+  uint8_t span = x1 - x0 + 1;
+
+  for (uint8_t page = page0; page <= page1; ++page) {
+    uint8_t low = page == page0 ? (y0 & 0b111) : 0;
+    uint8_t high = page == page1 ? (y1 & 0b111) : 7;
+    uint8_t mask = (0xFF << low) & (0xFF >> (7 - high));
+    uint8_t *row = &ssd->ram_buffer[page * ssd->width + x0];
+
+    if (mask == 0xFF) {
+      memset(row, value ? 0xFF : 0x00, span);
+    } else if (value) {
+      for (uint8_t i = 0; i < span; ++i) row[i] |= mask;
+    } else {
+      mask = ~mask;
+      for (uint8_t i = 0; i < span; ++i) row[i] &= mask;
     }
+  }
+  ssd1306_mark_dirty(ssd, x0, x1, page0, page1);
+}
+
+// Recorta e preenche a área x0..x1, y0..y1 (inclusivo)
+static void ssd1306_draw_area(ssd1306_t *ssd, int x0, int y0, int x1, int y1, bool value) {
+  if (ssd1306_clip(ssd, &x0, &y0, &x1, &y1)) {
+    ssd1306_fill_area(ssd, x0, y0, x1, y1, value);
+  }
+}
+
+void ssd1306_fill(ssd1306_t *ssd, bool value) {
+  memset(ssd->ram_buffer, value ? 0xFF : 0x00, ssd->bufsize);
+  ssd1306_mark_dirty(ssd, 0, ssd->width - 1, 0, ssd->pages - 1);
 }
 
 void ssd1306_rect(
@@ -102,22 +441,19 @@ void ssd1306_rect(
   uint8_t top, uint8_t left, uint8_t width, uint8_t height, 
   bool value, bool fill
 ) {
-  for (uint8_t x = left; x < left + width; ++x) {
-    ssd1306_pixel(ssd, x, top, value);
-    ssd1306_pixel(ssd, x, top + height - 1, value);
-  }
-  for (uint8_t y = top; y < top + height; ++y) {
-    ssd1306_pixel(ssd, left, y, value);
-    ssd1306_pixel(ssd, left + width - 1, y, value);
-  }
+  if (!width || !height) return;
+  int right = left + width - 1;
+  int bottom = top + height - 1;
 
   if (fill) {
-    for (uint8_t x = left + 1; x < left + width - 1; ++x) {
-      for (uint8_t y = top + 1; y < top + height - 1; ++y) {
-        ssd1306_pixel(ssd, x, y, value);
-      }
-    }
+    ssd1306_draw_area(ssd, left, top, right, bottom, value);
+    return;
   }
+
+  ssd1306_draw_area(ssd, left, top, right, top, value);
+  ssd1306_draw_area(ssd, left, bottom, right, bottom, value);
+  ssd1306_draw_area(ssd, left, top, left, bottom, value);
+  ssd1306_draw_area(ssd, right, top, right, bottom, value);
 }
 
 void ssd1306_line(
@@ -155,41 +491,64 @@ void ssd1306_line(
 }
 
 void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value) {
-  for (uint8_t x = x0; x <= x1; ++x)
-    ssd1306_pixel(ssd, x, y, value);
+  // Um bit na mesma posição em uma faixa contínua de bytes da página
+  if (x0 > x1) { uint8_t t = x0; x0 = x1; x1 = t; }
+  ssd1306_draw_area(ssd, x0, y, x1, y, value);
 }
 
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
-  for (uint8_t y = y0; y <= y1; ++y)
-    ssd1306_pixel(ssd, x, y, value);
+  // Uma máscara de bits por página, em uma única coluna
+  if (y0 > y1) { uint8_t t = y0; y0 = y1; y1 = t; }
+  ssd1306_draw_area(ssd, x, y0, x, y1, value);
 }
 
-// Função para desenhar um caractere
-void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
-{
-  uint16_t index = 0;
-  if (c >= 'A' && c <= 'Z') {
-    // Para letras maiúsculas
-    // 7 - a
-    index = (c - 'A' + 1) * 8;
-
-  } else if (c >= '1' && c <= '0') {
-    // Para números
-    index = (c - '1' + 27) * 8;
-
-  } else if (c >= 'a' && c <= 'z') {
-    // Para letras minúsculas
-    index = (c - 'a' + 37) * 8;
+// Retorna as colunas do glifo do caractere; caracteres fora da fonte
+// usam o glifo reservado para eles pelo compilador da fonte
+static const uint8_t *ssd1306_glyph(char c, uint8_t *index) {
+  if (c < FONT_FIRST_CHAR || c > FONT_LAST_CHAR) c = ' ';
+  *index = font_index[c - FONT_FIRST_CHAR];
+  return &font[*index * FONT_GLYPH_WIDTH];
+}
+
+// Copia as colunas de um glifo para o buffer a partir de (x, y)
+static void ssd1306_blit(ssd1306_t *ssd, 
+  const uint8_t *glyph, uint8_t columns, uint8_t x, uint8_t y
+) {
+  if (x >= ssd->width || y >= ssd->height || !columns) return;
+  if (ssd->width - x < columns) columns = ssd->width - x;
+  uint8_t page = y >> 3;
+  uint8_t shift = y & 0b111;
+  uint8_t *top = &ssd->ram_buffer[page * ssd->width + x];
+
+  if (!shift) {
+    // Alinhado à página: as colunas do caractere são bytes da página
+    memcpy(top, glyph, columns);
+    ssd1306_mark_dirty(ssd, x, x + columns - 1, page, page);
+    return;
   }
-  
-  for (uint8_t i = 0; i < 8; ++i)
-  {
-    uint8_t line = font[index + i];
-    for (uint8_t j = 0; j < 8; ++j)
-    {
-      ssd1306_pixel(ssd, x + i, y + j, line & (1 << j));
+
+  // Desalinhado: a parte de cima do caractere vai para o fim desta
+  // página e a de baixo para o começo da seguinte
+  uint8_t keep_top = 0xFF >> (8 - shift);
+  for (uint8_t i = 0; i < columns; ++i) {
+    top[i] = (top[i] & keep_top) | (glyph[i] << shift);
+  }
+  if (page + 1 < ssd->pages) {
+    uint8_t *bottom = top + ssd->width;
+    uint8_t keep_bottom = 0xFF << shift;
+    for (uint8_t i = 0; i < columns; ++i) {
+      bottom[i] = (bottom[i] & keep_bottom) | (glyph[i] >> (8 - shift));
     }
+    ++page;
   }
+  ssd1306_mark_dirty(ssd, x, x + columns - 1, y >> 3, page);
+}
+
+// Função para desenhar um caractere
+void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
+{
+  uint8_t index;
+  ssd1306_blit(ssd, ssd1306_glyph(c, &index), FONT_GLYPH_WIDTH, x, y);
 }
 
 // Função para desenhar uma string
@@ -211,9 +570,59 @@ void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y)
   }
 }
 
+#ifdef FONT_PROPORTIONAL
+// Função para desenhar uma string com a largura própria de cada caractere
+void ssd1306_draw_string_proportional(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y)
+{
+  while (*str)
+  {
+    uint8_t index;
+    const uint8_t *glyph = ssd1306_glyph(*str++, &index);
+    uint8_t width = font_width[index];
+    // Espaços também avançam o cursor só até a borda, como no desenho de
+    // largura fixa; sem isso, uma sequência deles dá a volta no cursor
+    if (!width)
+    {
+      x += FONT_BLANK_WIDTH;
+      if (x + FONT_BLANK_WIDTH >= ssd->width)
+      {
+        x = 0;
+        y += 8;
+      }
+      if (y + 8 >= ssd->height)
+      {
+        break;
+      }
+      continue;
+    }
+    if (x + width >= ssd->width)
+    {
+      x = 0;
+      y += 8;
+    }
+    if (y + 8 >= ssd->height)
+    {
+      break;
+    }
+    ssd1306_blit(ssd, glyph + font_offset[index], width, x, y);
+    x += width + FONT_SPACING;
+  }
+}
+#endif
+
+// Velocidades padrão do barramento do display, da mais rápida para a mais
+// lenta. A configurada (DISPLAY_I2C_MAX_HZ) é tentada primeiro e, se falhar,
+// as desta lista abaixo dela; a primeira que passar no teste de envio é
+// mantida
+static const uint display_bus_speeds[] = {
+  1000 * 1000, // Fast-mode Plus
+  400 * 1000,  // Fast-mode
+  100 * 1000   // Standard-mode
+};
+
 void setup_display_oled() {
-  // I2C Initialisation. Using it at 400Khz.
-  i2c_init(I2C_PORT, 400 * 1000);
+  // I2C Initialisation. Começa na maior velocidade permitida
+  i2c_init(I2C_PORT, DISPLAY_I2C_MAX_HZ);
   // Set the GPIO pin function to I2C
   gpio_set_function(I2C_SDA, GPIO_FUNC_I2C); 
   // Set the GPIO pin function to I2C
@@ -226,10 +635,24 @@ void setup_display_oled() {
 
   // Inicializa o display
   ssd1306_init(&ssd, WIDTH, HEIGHT, false, endereco, I2C_PORT); 
-  // Configura o display
-  ssd1306_config(&ssd); 
-  // Envia os dados para o display
-  ssd1306_send_data(&ssd);
+
+  // Configura o display e mede a taxa real de envio em cada velocidade,
+  // descendo para a próxima se algum byte não for confirmado
+  const uint speeds = sizeof(display_bus_speeds) / sizeof(display_bus_speeds[0]);
+  uint hz = DISPLAY_I2C_MAX_HZ;
+  uint next = 0;
+  while (true) {
+    ssd.bus_hz = i2c_set_baudrate(I2C_PORT, hz);
+    uint32_t errors = ssd.bus_errors;
+    ssd1306_config(&ssd);
+    if (ssd.bus_errors == errors && ssd1306_bus_test(&ssd, DISPLAY_BUS_TEST_FRAMES)) break;
+    while (next < speeds && display_bus_speeds[next] >= hz) next++;
+    if (next == speeds) break;
+    hz = display_bus_speeds[next];
+  }
+
+  // A partir daqui os envios são feitos por DMA, sem bloquear
+  ssd1306_dma_init(&ssd);
 }
 
 void display_fill(bool color) {
@@ -250,9 +673,52 @@ void display_draw_string(const char *string, uint8_t x, uint8_t y) {
   ssd1306_draw_string(&ssd, string, x, y);
 }
 
+#ifdef FONT_PROPORTIONAL
+void display_draw_string_proportional(const char *string, uint8_t x, uint8_t y) {
+  // Desenha uma string com espaçamento proporcional
+  ssd1306_draw_string_proportional(&ssd, string, x, y);
+}
+#endif
+
 void display_send_data() {
-  // Envia para o display
-  ssd1306_send_data(&ssd);
+  // Inicia o envio das regiões modificadas sem esperar o barramento.
+  // Se o quadro anterior ainda estiver sendo transmitido, display_task
+  // envia as mudanças acumuladas assim que ele terminar
+  uint32_t interrupts = save_and_disable_interrupts();
+  ssd1306_send_data_async(&ssd);
+  restore_interrupts(interrupts);
+}
+
+void display_task() {
+  // Conclui o envio em andamento e despacha as mudanças pendentes
+  uint32_t interrupts = save_and_disable_interrupts();
+  if (ssd1306_poll(&ssd) && ssd1306_pending(&ssd)) {
+    ssd1306_send_data_async(&ssd);
+  }
+  restore_interrupts(interrupts);
+}
+
+bool display_busy() {
+  // Há um quadro no barramento ou mudanças esperando para serem enviadas.
+  // O fim do DMA não gera interrupção: o laço precisa continuar consultando
+  return ssd.in_flight || ssd1306_pending(&ssd);
+}
+
+void display_power(bool on) {
+  // Liga ou desliga o painel, depois de concluir o envio em andamento. A
+  // GDDRAM é mantida com o painel desligado
+  ssd1306_wait(&ssd);
+  ssd1306_command(&ssd, SET_DISP | (on ? 0x01 : 0x00));
+}
+
+uint32_t display_bus_rate() {
+  // Bytes por segundo medidos no teste de envio da inicialização
+  return ssd.bus_bytes_per_second;
+}
+
+size_t display_flush_bytes() {
+  // Bytes enviados ao display no último envio
+  return ssd.flush_bytes;
 }
 
 void print_hid_function(const char *string) {
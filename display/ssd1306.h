@@ -1,10 +1,21 @@
+#ifndef SSD1306_H
+#define SSD1306_H
+
 #include <stdlib.h>
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
+#include "hardware/dma.h"
+#include "hardware/sync.h"
 
 #define WIDTH 128
 #define HEIGHT 64
 
+// Quantidade de comandos acumulados antes de um envio em lote
+#define SSD1306_BATCH_SIZE 32
+
+// Maior quantidade de páginas (linhas de 8 pixels) suportada pelo controlador
+#define SSD1306_MAX_PAGES 8
+
 typedef enum {
   SET_CONTRAST = 0x81,
   SET_ENTIRE_ON = 0xA4,
@@ -25,14 +36,49 @@ typedef enum {
   SET_CHARGE_PUMP = 0x8D
 } ssd1306_command_t;
 
-typedef struct {
+typedef struct ssd1306 ssd1306_t;
+
+// Chamada quando um envio assíncrono termina (ok = false se o display não
+// confirmou algum byte)
+typedef void (*ssd1306_flush_cb_t)(ssd1306_t *ssd, bool ok);
+
+struct ssd1306 {
   uint8_t width, height, pages, address;
   i2c_inst_t *i2c_port;
   bool external_vcc;
   uint8_t *ram_buffer;
   size_t bufsize;
   uint8_t port_buffer[2];
-} ssd1306_t;
+  // Buffer de transmissão: comandos de endereçamento e dados de uma janela
+  uint8_t *tx_buffer;
+  // Comandos acumulados para envio em uma única transação
+  uint8_t batch[SSD1306_BATCH_SIZE + 1];
+  uint8_t batch_length;
+  // Região suja: bit n indica que a página n mudou desde o último envio,
+  // e dirty_x0/dirty_x1 guardam o intervalo de colunas modificado nela
+  uint8_t dirty_pages;
+  uint8_t dirty_x0[SSD1306_MAX_PAGES];
+  uint8_t dirty_x1[SSD1306_MAX_PAGES];
+  // Bytes escritos no barramento pelo último envio e pelo total de envios
+  size_t flush_bytes;
+  uint32_t total_bytes;
+  // Envio assíncrono: o buffer frontal guarda a sequência de palavras
+  // (byte + bit de STOP) que o DMA copia para a FIFO de transmissão do I2C,
+  // enquanto o desenho continua no ram_buffer (buffer traseiro)
+  int dma_channel;
+  uint16_t *front_buffer;
+  size_t front_capacity;
+  size_t front_length;
+  volatile bool in_flight;
+  ssd1306_flush_cb_t flush_cb;
+  // Linha da GDDRAM exibida no topo do painel (rolagem por hardware)
+  uint8_t start_line;
+  bool start_line_dirty;
+  // Barramento: escritas sem ACK, clock escolhido e taxa medida
+  uint32_t bus_errors;
+  uint bus_hz;
+  uint32_t bus_bytes_per_second;
+};
 
 void ssd1306_init(ssd1306_t *ssd, 
   uint8_t width, uint8_t height, 
@@ -40,7 +86,19 @@ void ssd1306_init(ssd1306_t *ssd,
 );
 void ssd1306_config(ssd1306_t *ssd);
 void ssd1306_command(ssd1306_t *ssd, uint8_t command);
+void ssd1306_batch_command(ssd1306_t *ssd, uint8_t command);
+void ssd1306_batch_send(ssd1306_t *ssd);
+void ssd1306_commands(ssd1306_t *ssd, const uint8_t *commands, size_t count);
 void ssd1306_send_data(ssd1306_t *ssd);
+void ssd1306_dma_init(ssd1306_t *ssd);
+bool ssd1306_send_data_async(ssd1306_t *ssd);
+bool ssd1306_poll(ssd1306_t *ssd);
+void ssd1306_wait(ssd1306_t *ssd);
+void ssd1306_set_flush_callback(ssd1306_t *ssd, ssd1306_flush_cb_t cb);
+bool ssd1306_pending(ssd1306_t *ssd);
+void ssd1306_set_start_line(ssd1306_t *ssd, uint8_t line);
+bool ssd1306_bus_test(ssd1306_t *ssd, uint8_t frames);
+void ssd1306_mark_dirty(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t page0, uint8_t page1);
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value);
 void ssd1306_fill(ssd1306_t *ssd, bool value);
 void ssd1306_rect(ssd1306_t *ssd, 
@@ -52,10 +110,20 @@ void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value);
 void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y);
 void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
+void ssd1306_draw_string_proportional(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
 
 ssd1306_t ssd;
 
 #define I2C_PORT i2c1
 #define I2C_SDA 14
 #define I2C_SCL 15
-#define endereco 0x3C
\ No newline at end of file
+#define endereco 0x3C
+
+// Velocidade máxima do barramento do display (até 1 MHz, Fast-mode Plus)
+#ifndef DISPLAY_I2C_MAX_HZ
+#define DISPLAY_I2C_MAX_HZ (1000 * 1000)
+#endif
+// Quadros enviados no teste de velocidade da inicialização
+#define DISPLAY_BUS_TEST_FRAMES 3
+
+#endif
@@ -0,0 +1,98 @@
+// Fila de relatórios HID pendentes, uma por ID de relatório. Cada entrada é
+// o estado completo do relatório naquele momento: um toque de tecla vira
+// um relatório com a tecla pressionada seguido de outro com ela solta, e o
+// computador recebe os dois na ordem, mesmo que a tecla se repita antes do
+// primeiro sair.
+//
+// Um estado igual ao último enfileirado é descartado, porque não muda nada
+// no computador. As filas são esvaziadas uma entrada por vez, quando o
+// endpoint da sua interface fica livre
+
+// Entradas por fila
+#define HID_QUEUE_DEPTH 16
+// Maior relatório guardado, sem o ID
+#define HID_QUEUE_REPORT_SIZE 8
+
+typedef struct {
+  uint8_t data[HID_QUEUE_REPORT_SIZE];
+  // Instante da entrada que gerou o relatório, para a medição de latência
+  uint32_t input_us;
+  bool has_input;
+} hid_pending_report_t;
+
+typedef struct {
+  // Interface HID e ID do relatório
+  uint8_t instance;
+  uint8_t report_id;
+  uint8_t length;
+  hid_pending_report_t reports[HID_QUEUE_DEPTH];
+  uint8_t head;
+  uint8_t count;
+  // Último estado enfileirado (ou enviado, com a fila vazia)
+  uint8_t state[HID_QUEUE_REPORT_SIZE];
+  // Estados que não couberam e substituíram o último da fila
+  uint32_t overflows;
+} hid_report_queue_t;
+
+void hid_queue_init(
+  hid_report_queue_t *queue, uint8_t instance, uint8_t report_id, uint8_t length
+) {
+  memset(queue, 0, sizeof(*queue));
+  queue->instance = instance;
+  queue->report_id = report_id;
+  queue->length = length;
+}
+
+// Entradas livres na fila
+static inline uint hid_queue_space(const hid_report_queue_t *queue) {
+  return HID_QUEUE_DEPTH - queue->count;
+}
+
+static inline bool hid_queue_empty(const hid_report_queue_t *queue) {
+  return queue->count == 0;
+}
+
+// Último estado enfileirado, que o computador terá depois de esvaziar a fila
+static inline const uint8_t *hid_queue_state(const hid_report_queue_t *queue) {
+  return queue->state;
+}
+
+// Enfileira um novo estado do relatório. Retorna false se ele for igual ao
+// anterior e não precisar ser enviado. Com a fila cheia, o novo estado
+// substitui o último enfileirado, e a substituição é contada
+bool hid_queue_push(
+  hid_report_queue_t *queue, const uint8_t *data, bool has_input, uint32_t input_us
+) {
+  if (memcmp(data, queue->state, queue->length) == 0) return false;
+  memcpy(queue->state, data, queue->length);
+
+  hid_pending_report_t *report;
+  if (queue->count == HID_QUEUE_DEPTH) {
+    queue->overflows++;
+    report = &queue->reports[(queue->head + queue->count - 1) % HID_QUEUE_DEPTH];
+  } else {
+    report = &queue->reports[(queue->head + queue->count) % HID_QUEUE_DEPTH];
+    queue->count++;
+    report->has_input = false;
+  }
+
+  memcpy(report->data, data, queue->length);
+  // Um relatório substituído mantém a entrada mais antiga
+  if (!report->has_input) {
+    report->has_input = has_input;
+    report->input_us = input_us;
+  }
+  return true;
+}
+
+// Relatório mais antigo da fila, ou NULL se ela estiver vazia
+hid_pending_report_t *hid_queue_peek(hid_report_queue_t *queue) {
+  if (!queue->count) return NULL;
+  return &queue->reports[queue->head];
+}
+
+// Retira o relatório mais antigo, depois de enviado
+void hid_queue_pop(hid_report_queue_t *queue) {
+  queue->head = (queue->head + 1) % HID_QUEUE_DEPTH;
+  queue->count--;
+}
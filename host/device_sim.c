@@ -0,0 +1,414 @@
+// Executa o firmware inteiro no host, sobre a placa e o computador
+// simulados e um relógio virtual. Lê um roteiro de entradas e escreve cada
+// relatório HID recebido pelo computador e cada quadro enviado ao display,
+// com o instante virtual em que aconteceram. O núcleo 1 roda no mesmo
+// fluxo, uma volta de ui_core1_task por volta do laço principal.
+//
+//   device_sim <roteiro> [diretório para os quadros em PNG]
+//
+// O roteiro tem um evento por linha, "<ms> <comando> [argumentos]", em
+// ordem de tempo; linhas vazias e começadas por # são ignoradas:
+//   <ms> press A|B|JOY|BOOT      aperta um botão
+//   <ms> release A|B|JOY|BOOT    solta um botão
+//   <ms> joystick <x> <y>        leituras do ADC de cada eixo (0 a 4095)
+//   <ms> suspend [wakeup]        suspende o USB, permitindo remote wakeup
+//   <ms> resume                  retoma o USB
+//   <ms> end                     encerra a simulação
+//
+// e verificações, que fazem a simulação terminar com erro se falharem:
+//   <ms> expect keyboard [tecla...]       teclas (em hexadecimal) do último
+//                                         relatório do teclado
+//   <ms> expect keys [tecla...]           teclas apertadas, na ordem, desde a
+//                                         verificação keys anterior
+//   <ms> expect mouse <botões> <x> <y>    último relatório do mouse
+//   <ms> expect mouse_step <máximo>       nenhum relatório do mouse desde a
+//                                         verificação mouse_step anterior
+//                                         moveu mais que isso em um eixo
+//   <ms> expect gamepad <botões> <x> <y>  último relatório do gamepad
+//   <ms> expect function <n>              função atual (0 a 3)
+//   <ms> expect wakeup                    o último remote wakeup chegou ao
+//                                         primeiro relatório
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "pico_stubs.h"
+#include "ssd1306_emulator.h"
+
+#include "../main.c"
+
+#define SIM_MAX_EVENTS 1024
+// Valores de uma verificação: até seis teclas ou botões e eixos
+#define SIM_MAX_VALUES 6
+// Teclas apertadas guardadas para a verificação keys
+#define SIM_MAX_KEYS 64
+
+typedef enum {
+  SIM_PRESS,
+  SIM_RELEASE,
+  SIM_JOYSTICK,
+  SIM_SUSPEND,
+  SIM_RESUME,
+  SIM_END,
+  SIM_EXPECT
+} sim_command_t;
+
+typedef enum {
+  EXPECT_KEYBOARD,
+  EXPECT_KEYS,
+  EXPECT_MOUSE,
+  EXPECT_MOUSE_STEP,
+  EXPECT_GAMEPAD,
+  EXPECT_FUNCTION,
+  EXPECT_WAKEUP
+} sim_expect_t;
+
+typedef struct {
+  uint64_t time_us;
+  sim_command_t command;
+  // Botão (GPIO ou BUTTON_BOARD), posição do joystick, remote wakeup ou
+  // tipo de verificação
+  uint target;
+  uint16_t x, y;
+  // Valores esperados e linha do roteiro, para a mensagem de falha
+  int values[SIM_MAX_VALUES];
+  uint value_count;
+  uint line;
+} sim_event_t;
+
+static sim_event_t sim_events[SIM_MAX_EVENTS];
+static uint sim_event_count;
+static bool sim_running = true;
+
+static const char *frame_dir;
+static uint32_t frame_count;
+static uint32_t report_count;
+static uint32_t failures;
+
+// Estado visto pelo computador: último relatório de cada interface, teclas
+// apertadas desde a última verificação keys e maior passo do mouse desde a
+// última verificação mouse_step
+static hid_keyboard_report_t host_keyboard;
+static hid_mouse_report_t host_mouse;
+static gamepad_report_t host_gamepad;
+static uint8_t host_keys[SIM_MAX_KEYS];
+static uint host_key_count;
+static int host_mouse_step;
+
+static bool sim_parse_button(const char *name, uint *button) {
+  if (!strcmp(name, "A")) *button = BUTTON_A;
+  else if (!strcmp(name, "B")) *button = BUTTON_B;
+  else if (!strcmp(name, "JOY")) *button = JOYSTICK_BUTTON;
+  else if (!strcmp(name, "BOOT")) *button = BUTTON_BOARD;
+  else return false;
+  return true;
+}
+
+static bool sim_parse_expect(const char *line, sim_event_t *event) {
+  static const char *names[] = {
+    [EXPECT_KEYBOARD] = "keyboard", [EXPECT_KEYS] = "keys",
+    [EXPECT_MOUSE] = "mouse", [EXPECT_MOUSE_STEP] = "mouse_step",
+    [EXPECT_GAMEPAD] = "gamepad", [EXPECT_FUNCTION] = "function",
+    [EXPECT_WAKEUP] = "wakeup",
+  };
+  // Quantidade de valores de cada verificação; -1 aceita de 0 a 6 teclas
+  static const int counts[] = {
+    [EXPECT_KEYBOARD] = -1, [EXPECT_KEYS] = -1, [EXPECT_MOUSE] = 3,
+    [EXPECT_MOUSE_STEP] = 1, [EXPECT_GAMEPAD] = 3, [EXPECT_FUNCTION] = 1,
+    [EXPECT_WAKEUP] = 0,
+  };
+
+  char name[16];
+  int offset;
+  if (sscanf(line, "%*u %*s %15s%n", name, &offset) != 1) return false;
+  uint kind = 0;
+  while (kind < sizeof(names) / sizeof(names[0]) && strcmp(name, names[kind])) kind++;
+  if (kind == sizeof(names) / sizeof(names[0])) return false;
+
+  bool keys = kind == EXPECT_KEYBOARD || kind == EXPECT_KEYS;
+  const char *cursor = line + offset;
+  int value, length;
+  while (event->value_count < SIM_MAX_VALUES &&
+         sscanf(cursor, keys ? " %x%n" : " %d%n", &value, &length) == 1) {
+    event->values[event->value_count++] = value;
+    cursor += length;
+  }
+  if (sscanf(cursor, " %*s") != EOF) return false;
+  if (counts[kind] >= 0 && event->value_count != (uint)counts[kind]) return false;
+
+  event->command = SIM_EXPECT;
+  event->target = kind;
+  return true;
+}
+
+static bool sim_load(const char *path) {
+  FILE *file = fopen(path, "r");
+  if (!file) {
+    perror(path);
+    return false;
+  }
+
+  char line[128];
+  uint line_number = 0;
+  uint64_t last_us = 0;
+  while (fgets(line, sizeof(line), file)) {
+    line_number++;
+    char command[16] = "", argument[16] = "";
+    unsigned long ms;
+    unsigned x = 0, y = 0;
+    if (line[0] == '#' || sscanf(line, "%lu %15s", &ms, command) < 2) continue;
+
+    sim_event_t *event = &sim_events[sim_event_count];
+    memset(event, 0, sizeof(*event));
+    event->time_us = (uint64_t)ms * 1000;
+    if ((!strcmp(command, "press") || !strcmp(command, "release")) &&
+        sscanf(line, "%*u %*s %15s", argument) == 1 &&
+        sim_parse_button(argument, &event->target)) {
+      event->command = command[0] == 'p' ? SIM_PRESS : SIM_RELEASE;
+    } else if (!strcmp(command, "joystick") && sscanf(line, "%*u %*s %u %u", &x, &y) == 2) {
+      event->command = SIM_JOYSTICK;
+      event->x = x;
+      event->y = y;
+    } else if (!strcmp(command, "suspend")) {
+      event->command = SIM_SUSPEND;
+      event->target = sscanf(line, "%*u %*s %15s", argument) == 1 && !strcmp(argument, "wakeup");
+    } else if (!strcmp(command, "resume")) {
+      event->command = SIM_RESUME;
+    } else if (!strcmp(command, "end")) {
+      event->command = SIM_END;
+    } else if (!strcmp(command, "expect") && sim_parse_expect(line, event)) {
+      event->line = line_number;
+    } else {
+      fprintf(stderr, "%s:%u: comando inválido\n", path, line_number);
+      fclose(file);
+      return false;
+    }
+    if (event->time_us < last_us || sim_event_count + 1 == SIM_MAX_EVENTS) {
+      fprintf(stderr, "%s:%u: evento fora de ordem ou roteiro longo demais\n", path, line_number);
+      fclose(file);
+      return false;
+    }
+    last_us = event->time_us;
+    sim_event_count++;
+  }
+  fclose(file);
+
+  // Sem "end", a simulação segue um segundo depois do último evento
+  if (!sim_event_count || sim_events[sim_event_count - 1].command != SIM_END) {
+    sim_events[sim_event_count].time_us = last_us + 1000000;
+    sim_events[sim_event_count].command = SIM_END;
+    sim_event_count++;
+  }
+  return true;
+}
+
+// Compara uma lista de teclas com a esperada, ignorando as posições vazias
+// do relatório
+static bool sim_keys_match(const uint8_t *keys, uint count, const sim_event_t *event) {
+  uint found = 0;
+  for (uint i = 0; i < count; ++i) {
+    if (!keys[i]) continue;
+    if (found == event->value_count || keys[i] != event->values[found]) return false;
+    found++;
+  }
+  return found == event->value_count;
+}
+
+static void sim_print_time(uint64_t time_us) {
+  printf("%8llu.%03llu ", (unsigned long long)(time_us / 1000), (unsigned long long)(time_us % 1000));
+}
+
+// Confere uma verificação do roteiro com o que o computador recebeu
+static void sim_expect(const sim_event_t *event) {
+  const int *values = event->values;
+  char actual[64];
+  bool ok;
+
+  switch (event->target) {
+    case EXPECT_KEYBOARD:
+      ok = sim_keys_match(host_keyboard.keycode, 6, event);
+      snprintf(actual, sizeof(actual), "%02x %02x %02x %02x %02x %02x",
+        host_keyboard.keycode[0], host_keyboard.keycode[1], host_keyboard.keycode[2],
+        host_keyboard.keycode[3], host_keyboard.keycode[4], host_keyboard.keycode[5]);
+      break;
+    case EXPECT_KEYS: {
+      ok = sim_keys_match(host_keys, host_key_count, event);
+      int length = 0;
+      actual[0] = '\0';
+      for (uint i = 0; i < host_key_count && length < (int)sizeof(actual) - 4; ++i) {
+        length += snprintf(actual + length, sizeof(actual) - length, "%02x ", host_keys[i]);
+      }
+      host_key_count = 0;
+      break;
+    }
+    case EXPECT_MOUSE:
+      ok = host_mouse.buttons == values[0] && host_mouse.x == values[1] && host_mouse.y == values[2];
+      snprintf(actual, sizeof(actual), "%u %d %d", host_mouse.buttons, host_mouse.x, host_mouse.y);
+      break;
+    case EXPECT_MOUSE_STEP:
+      ok = host_mouse_step <= values[0];
+      snprintf(actual, sizeof(actual), "%d", host_mouse_step);
+      host_mouse_step = 0;
+      break;
+    case EXPECT_GAMEPAD:
+      ok = host_gamepad.buttons == (uint32_t)values[0] && host_gamepad.x == values[1] &&
+           host_gamepad.y == values[2];
+      snprintf(actual, sizeof(actual), "%lu %d %d",
+        (unsigned long)host_gamepad.buttons, host_gamepad.x, host_gamepad.y);
+      break;
+    case EXPECT_FUNCTION:
+      ok = hid_function == (uint)values[0];
+      snprintf(actual, sizeof(actual), "%u", hid_function);
+      break;
+    default:
+      ok = !power.suspended && !power.wakeup_report_pending && power.wakeup_to_report_us;
+      snprintf(actual, sizeof(actual), "retomada %lu us, relatorio %lu us",
+        (unsigned long)power.wakeup_to_resume_us, (unsigned long)power.wakeup_to_report_us);
+      break;
+  }
+
+  sim_print_time(time_us_64());
+  printf("linha %u: %s (%s)\n", event->line, ok ? "ok" : "FALHOU", actual);
+  if (!ok) failures++;
+}
+
+// Aplica um evento do roteiro no instante dele, como uma interrupção
+static int64_t sim_event_alarm(alarm_id_t id, void *user_data) {
+  (void)id;
+  const sim_event_t *event = user_data;
+
+  switch (event->command) {
+    case SIM_PRESS:
+    case SIM_RELEASE: {
+      bool pressed = event->command == SIM_PRESS;
+      if (event->target == BUTTON_BOARD) host_bootsel_set(pressed);
+      else host_gpio_set(event->target, !pressed);
+      break;
+    }
+    case SIM_JOYSTICK:
+      host_adc_set(JOYSTICK_X_INPUT, event->x);
+      host_adc_set(JOYSTICK_Y_INPUT, event->y);
+      break;
+    case SIM_SUSPEND:
+      host_usb_suspend(event->target);
+      break;
+    case SIM_RESUME:
+      host_usb_resume();
+      break;
+    case SIM_END:
+      sim_running = false;
+      break;
+    case SIM_EXPECT:
+      sim_expect(event);
+      break;
+  }
+  return 0;
+}
+
+// Relatório lido pelo computador simulado
+static void sim_report(uint8_t instance, uint8_t report_id,
+  const uint8_t *report, uint16_t len, uint64_t sent_us
+) {
+  report_count++;
+  sim_print_time(time_us_64());
+  if (instance == HID_ITF_KEYBOARD && len == sizeof(hid_keyboard_report_t)) {
+    const hid_keyboard_report_t *keyboard = (const hid_keyboard_report_t *)report;
+    printf("teclado  mod %02x teclas", keyboard->modifier);
+    for (uint i = 0; i < 6; ++i) printf(" %02x", keyboard->keycode[i]);
+    // Teclas que não estavam no relatório anterior foram apertadas agora
+    for (uint i = 0; i < 6; ++i) {
+      uint8_t key = keyboard->keycode[i];
+      if (!key || memchr(host_keyboard.keycode, key, 6)) continue;
+      if (host_key_count < SIM_MAX_KEYS) host_keys[host_key_count++] = key;
+    }
+    host_keyboard = *keyboard;
+  } else if (instance == HID_ITF_MOUSE && len == sizeof(hid_mouse_report_t)) {
+    const hid_mouse_report_t *mouse = (const hid_mouse_report_t *)report;
+    printf("mouse    botoes %u x %d y %d", mouse->buttons, mouse->x, mouse->y);
+    host_mouse_step = MAX(host_mouse_step, MAX(abs(mouse->x), abs(mouse->y)));
+    host_mouse = *mouse;
+  } else if (instance == HID_ITF_GAMEPAD && len == sizeof(gamepad_report_t)) {
+    const gamepad_report_t *gamepad = (const gamepad_report_t *)report;
+    printf("gamepad  botoes %lu x %d y %d", (unsigned long)gamepad->buttons, gamepad->x, gamepad->y);
+    host_gamepad = *gamepad;
+  } else {
+    printf("itf %u id %u", instance, report_id);
+    for (uint i = 0; i < len; ++i) printf(" %02x", report[i]);
+  }
+  printf("  (enviado %llu us antes)\n", (unsigned long long)(time_us_64() - sent_us));
+}
+
+// Quadro que terminou de ser enviado ao display
+static void sim_frame(ssd1306_t *display, bool ok) {
+  frame_count++;
+  sim_print_time(time_us_64());
+  printf("quadro   %u, %zu bytes%s\n", frame_count, display->flush_bytes, ok ? "" : ", erro no barramento");
+
+  if (frame_dir) {
+    char path[256];
+    snprintf(path, sizeof(path), "%s/quadro_%04u.png", frame_dir, frame_count);
+    ssd1306_emulator_write_png(&emulator, path, 4);
+  }
+}
+
+// Uma volta do núcleo 1; também roda enquanto o núcleo 0 espera por ele
+static uint32_t core1_wait_us = UINT32_MAX;
+
+static void sim_core1(void) {
+  static bool running = false;
+  if (running) return;
+  running = true;
+  core1_wait_us = ui_core1_task();
+  running = false;
+}
+
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    fprintf(stderr, "uso: %s <roteiro> [diretório dos quadros]\n", argv[0]);
+    return 1;
+  }
+  if (!sim_load(argv[1])) return 1;
+  if (argc > 2) frame_dir = argv[2];
+
+  ssd1306_emulator_init(&emulator);
+  host_usb_set_report_callback(sim_report);
+  // Joystick em repouso até o roteiro dizer o contrário
+  host_adc_set(JOYSTICK_X_INPUT, JOYSTICK_MIDDLE_X);
+  host_adc_set(JOYSTICK_Y_INPUT, JOYSTICK_MIDDLE_Y);
+  for (uint i = 0; i < sim_event_count; ++i) {
+    add_alarm_at(sim_events[i].time_us, sim_event_alarm, &sim_events[i], true);
+  }
+
+  struct timespec wall_start, wall_end;
+  clock_gettime(CLOCK_MONOTONIC, &wall_start);
+
+  // Eventos no instante 0 valem desde a inicialização (por exemplo, o
+  // botão do joystick seguro para calibrar)
+  host_run_until(0);
+  device_init();
+  ssd1306_set_flush_callback(&ssd, sim_frame);
+  host_set_idle_hook(sim_core1);
+
+  while (sim_running) {
+    device_task();
+    sim_core1();
+    if (core1_wait_us != UINT32_MAX) power_deadline_in(core1_wait_us);
+    power_sleep();
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &wall_end);
+  double wall_s = (wall_end.tv_sec - wall_start.tv_sec) + (wall_end.tv_nsec - wall_start.tv_nsec) / 1e9;
+  double virtual_s = time_us_64() / 1e6;
+
+  printf("\n");
+  latency_print_all();
+  printf("%u relatorios, %u quadros em %.3f s virtuais (%.3f s reais, %.0fx)\n",
+    report_count, frame_count, virtual_s, wall_s, wall_s > 0 ? virtual_s / wall_s : 0);
+  if (failures) {
+    printf("%u verificacoes falharam\n", failures);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,172 @@
+// Passa traços de um eixo do joystick (host/traces) pelo filtro de tremor
+// com o perfil de cada função e mede, contra a posição pretendida:
+//   tremor  desvio RMS da posição filtrada enquanto a pretendida está
+//           parada há pelo menos TRACE_MAX_LAG passos
+//   atraso  deslocamento no tempo que melhor alinha a posição filtrada à
+//           pretendida, fora dos degraus
+//   degrau  maior tempo para a posição filtrada cobrir 90% de um degrau
+//           da posição pretendida
+// O atraso e o degrau de cada perfil não podem passar de
+// JOYSTICK_FILTER_MAX_LAG_US e, nos traços em que a posição pretendida não
+// se move, o tremor filtrado não pode passar de TRACE_MAX_REST_TREMOR% do
+// da entrada
+//
+//   joystick_filter_test <traço>...
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../main.c"
+
+#define TRACE_MAX_SAMPLES 8192
+// Maior atraso procurado, em passos
+#define TRACE_MAX_LAG 50
+// Menor variação da posição pretendida em um passo que conta como degrau
+#define TRACE_STEP 256
+
+// Maior tremor filtrado com o joystick parado, em % do tremor da entrada
+#define TRACE_MAX_REST_TREMOR 50
+
+static int16_t trace_input[TRACE_MAX_SAMPLES];
+static int16_t trace_intended[TRACE_MAX_SAMPLES];
+static int16_t trace_output[TRACE_MAX_SAMPLES];
+static uint trace_length;
+
+static bool trace_load(const char *path) {
+  FILE *file = fopen(path, "r");
+  if (!file) {
+    perror(path);
+    return false;
+  }
+  char line[128];
+  int input, intended;
+  trace_length = 0;
+  while (fgets(line, sizeof(line), file) && trace_length < TRACE_MAX_SAMPLES) {
+    if (line[0] == '#' || sscanf(line, "%d %d", &input, &intended) != 2) continue;
+    trace_input[trace_length] = input;
+    trace_intended[trace_length] = intended;
+    trace_length++;
+  }
+  fclose(file);
+  return trace_length > TRACE_MAX_LAG;
+}
+
+// Maior variação da posição pretendida em um passo, nos TRACE_MAX_LAG
+// passos até i
+static int trace_change(uint i) {
+  int change = 0;
+  for (uint j = i - TRACE_MAX_LAG + 1; j <= i; ++j) {
+    change = MAX(change, abs(trace_intended[j] - trace_intended[j - 1]));
+  }
+  return change;
+}
+
+// A posição pretendida não se move em todo o traço
+static bool trace_still(void) {
+  for (uint i = 1; i < trace_length; ++i) {
+    if (trace_intended[i] != trace_intended[0]) return false;
+  }
+  return true;
+}
+
+// Desvio RMS da saída com a posição pretendida parada; negativo se ela
+// nunca para
+static double trace_tremor(const int16_t *output) {
+  double sum = 0;
+  uint count = 0;
+  for (uint i = TRACE_MAX_LAG; i < trace_length; ++i) {
+    if (trace_change(i)) continue;
+    double error = output[i] - trace_intended[i];
+    sum += error * error;
+    count++;
+  }
+  return count ? sqrt(sum / count) : -1;
+}
+
+// Atraso que melhor alinha a saída à posição pretendida, fora dos
+// degraus. Em caso de empate fica o menor atraso
+static uint trace_lag(const int16_t *output) {
+  double best = INFINITY;
+  uint lag = 0;
+  for (uint shift = 0; shift <= TRACE_MAX_LAG; ++shift) {
+    double sum = 0;
+    for (uint i = TRACE_MAX_LAG; i < trace_length; ++i) {
+      if (trace_change(i) >= TRACE_STEP) continue;
+      double error = output[i] - trace_intended[i - shift];
+      sum += error * error;
+    }
+    if (sum < best) {
+      best = sum;
+      lag = shift;
+    }
+  }
+  return lag;
+}
+
+// Maior tempo, em passos, para a saída cobrir 90% de um degrau da posição
+// pretendida, contado a partir do passo do degrau
+static uint trace_step_response(const int16_t *output) {
+  uint worst = 0;
+  for (uint i = 1; i < trace_length; ++i) {
+    int32_t from = trace_intended[i - 1], to = trace_intended[i];
+    if (abs(to - from) < TRACE_STEP) continue;
+    int32_t target = from + (to - from) * 9 / 10;
+    uint steps = 0;
+    while (i + steps < trace_length &&
+           (to > from ? output[i + steps] < target : output[i + steps] > target)) {
+      steps++;
+    }
+    if (steps > worst) worst = steps;
+  }
+  return worst;
+}
+
+static void trace_print_tremor(double tremor) {
+  if (tremor < 0) printf("%7s", "-");
+  else printf("%7.1f", tremor);
+}
+
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    fprintf(stderr, "uso: %s <traço>...\n", argv[0]);
+    return 1;
+  }
+
+  uint failures = 0;
+  const uint32_t step_us = 1000000 / JOYSTICK_FILTER_RATE;
+  const uint32_t limit = JOYSTICK_FILTER_MAX_LAG_US / step_us;
+  printf("%-12s %-10s %7s %8s %8s %8s\n", "traço", "perfil", "tremor", "atraso", "degrau", "limite");
+  for (int arg = 1; arg < argc; ++arg) {
+    if (!trace_load(argv[arg])) {
+      fprintf(stderr, "%s: traço vazio ou curto demais\n", argv[arg]);
+      return 1;
+    }
+    const char *name = strrchr(argv[arg], '/') ? strrchr(argv[arg], '/') + 1 : argv[arg];
+
+    double input_tremor = trace_tremor(trace_input);
+    double max_tremor = trace_still() ? input_tremor * TRACE_MAX_REST_TREMOR / 100 : input_tremor;
+    printf("%-11s %-10s ", name, "entrada");
+    trace_print_tremor(input_tremor);
+    printf(" %5u ms %5u ms\n", trace_lag(trace_input), trace_step_response(trace_input));
+
+    for (uint function = 0; function < TOTAL_FUNCTIONS; ++function) {
+      joystick_filter_axis_t axis = {0};
+      for (uint i = 0; i < trace_length; ++i) {
+        trace_output[i] = joystick_filter_axis(
+          &axis, &joystick_filter_profiles[function], trace_input[i]
+        );
+      }
+
+      double tremor = trace_tremor(trace_output);
+      uint lag = trace_lag(trace_output);
+      uint step = trace_step_response(trace_output);
+      bool ok = lag <= limit && step <= limit && tremor <= max_tremor;
+      printf("%-11s %-10s ", "", hid_function_names[function]);
+      trace_print_tremor(tremor);
+      printf(" %5u ms %5u ms %5lu ms%s\n", lag, step, (unsigned long)limit, ok ? "" : "  FALHOU");
+      if (!ok) failures++;
+    }
+  }
+  return failures ? 1 : 0;
+}
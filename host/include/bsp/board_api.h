@@ -0,0 +1,15 @@
+// Substituto de bsp/board_api.h do TinyUSB: o LED e o botão BOOTSEL da
+// placa simulada
+#ifndef HOST_BSP_BOARD_API_H
+#define HOST_BSP_BOARD_API_H
+
+#include "pico/stdlib.h"
+
+#define BOARD_TUD_RHPORT 0
+
+void board_init(void);
+void board_led_write(bool state);
+uint32_t board_button_read(void);
+uint32_t board_millis(void);
+
+#endif
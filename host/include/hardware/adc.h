@@ -0,0 +1,24 @@
+// Substituto de hardware/adc.h: as conversões devolvem os valores definidos
+// por host_adc_set, copiados para o anel do DMA a cada leitura
+#ifndef HOST_HARDWARE_ADC_H
+#define HOST_HARDWARE_ADC_H
+
+#include "pico/stdlib.h"
+
+typedef struct {
+  volatile uint32_t fifo;
+} adc_hw_t;
+
+extern adc_hw_t host_adc_hw;
+#define adc_hw (&host_adc_hw)
+
+void adc_init(void);
+void adc_gpio_init(uint gpio);
+void adc_select_input(uint input);
+void adc_set_round_robin(uint input_mask);
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift);
+void adc_set_clkdiv(float clkdiv);
+void adc_run(bool run);
+void adc_fifo_drain(void);
+
+#endif
@@ -0,0 +1,49 @@
+// Substituto de hardware/i2c.h: as escritas vão para o emulador do SSD1306
+#ifndef HOST_HARDWARE_I2C_H
+#define HOST_HARDWARE_I2C_H
+
+#include "pico/stdlib.h"
+
+// Registradores do controlador I2C usados pelo envio por DMA
+typedef struct {
+  volatile uint32_t enable;
+  volatile uint32_t tar;
+  volatile uint32_t data_cmd;
+  volatile uint32_t status;
+  volatile uint32_t raw_intr_stat;
+  volatile uint32_t clr_tx_abrt;
+  volatile uint32_t dma_cr;
+} i2c_hw_t;
+
+typedef struct i2c_inst {
+  i2c_hw_t hw;
+  uint baudrate;
+} i2c_inst_t;
+
+extern i2c_inst_t i2c0_inst;
+extern i2c_inst_t i2c1_inst;
+#define i2c0 (&i2c0_inst)
+#define i2c1 (&i2c1_inst)
+
+#define PICO_ERROR_GENERIC -1
+
+#define I2C_IC_DATA_CMD_STOP_BITS 0x00000200
+#define I2C_IC_STATUS_ACTIVITY_BITS 0x00000001
+#define I2C_IC_STATUS_TFE_BITS 0x00000004
+#define I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS 0x00000040
+#define I2C_IC_DMA_CR_TDMAE_BITS 0x00000002
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate);
+uint i2c_set_baudrate(i2c_inst_t *i2c, uint baudrate);
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+
+static inline i2c_hw_t *i2c_get_hw(i2c_inst_t *i2c) {
+  return &i2c->hw;
+}
+
+static inline uint i2c_get_dreq(i2c_inst_t *i2c, bool is_tx) {
+  (void)i2c;
+  return is_tx ? 0 : 1;
+}
+
+#endif
@@ -0,0 +1,21 @@
+// Substituto de hardware/sync.h: no host não há interrupções para desativar
+#ifndef HOST_HARDWARE_SYNC_H
+#define HOST_HARDWARE_SYNC_H
+
+#include "pico/stdlib.h"
+
+static inline uint32_t save_and_disable_interrupts(void) {
+  return 0;
+}
+
+static inline void restore_interrupts(uint32_t status) {
+  (void)status;
+}
+
+static inline void __dmb(void) {}
+static inline void __sev(void) {}
+
+// Espera pela próxima interrupção simulada
+void __wfe(void);
+
+#endif
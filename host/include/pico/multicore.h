@@ -0,0 +1,15 @@
+// Substituto de pico/multicore.h: no host não há segundo núcleo. A entrada
+// do núcleo 1 é só guardada; a simulação executa a tarefa dele no mesmo
+// fluxo, de forma cooperativa
+#ifndef HOST_PICO_MULTICORE_H
+#define HOST_PICO_MULTICORE_H
+
+#include "pico/stdlib.h"
+
+void multicore_launch_core1(void (*entry)(void));
+
+static inline void multicore_lockout_victim_init(void) {}
+static inline void multicore_lockout_start_blocking(void) {}
+static inline void multicore_lockout_end_blocking(void) {}
+
+#endif
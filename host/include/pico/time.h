@@ -0,0 +1,32 @@
+// Substituto de pico/time.h: os alarmes disparam quando o relógio virtual
+// passa do instante marcado, como interrupções entre duas instruções
+#ifndef HOST_PICO_TIME_H
+#define HOST_PICO_TIME_H
+
+#include "pico/stdlib.h"
+
+typedef int32_t alarm_id_t;
+typedef int64_t (*alarm_callback_t)(alarm_id_t id, void *user_data);
+
+#define at_the_end_of_time ((absolute_time_t)UINT64_MAX)
+
+static inline absolute_time_t from_us_since_boot(uint64_t us) {
+  return us;
+}
+
+static inline absolute_time_t make_timeout_time_us(uint64_t us) {
+  return time_us_64() + us;
+}
+
+static inline absolute_time_t make_timeout_time_ms(uint32_t ms) {
+  return time_us_64() + (uint64_t)ms * 1000;
+}
+
+alarm_id_t add_alarm_at(absolute_time_t time, alarm_callback_t callback, void *user_data, bool fire_if_past);
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void *user_data, bool fire_if_past);
+bool cancel_alarm(alarm_id_t id);
+
+// Dorme até o instante ou até a próxima interrupção simulada
+bool best_effort_wfe_or_timeout(absolute_time_t timeout);
+
+#endif
@@ -0,0 +1,70 @@
+// Substituto de tusb.h: um computador simulado consulta cada endpoint HID a
+// cada HID_POLL_INTERVAL_MS no relógio virtual. Um relatório aceito ocupa o
+// endpoint até a próxima consulta, quando é registrado como recebido e
+// tud_task chama tud_hid_report_complete_cb
+#ifndef HOST_TUSB_H
+#define HOST_TUSB_H
+
+#include "pico/stdlib.h"
+
+// Códigos de uso do teclado (HID Usage Tables, página 0x07)
+#define HID_KEY_NONE 0x00
+#define HID_KEY_A 0x04
+#define HID_KEY_Z 0x1D
+#define HID_KEY_ENTER 0x28
+#define HID_KEY_BACKSPACE 0x2A
+#define HID_KEY_SPACE 0x2C
+#define HID_KEY_ARROW_RIGHT 0x4F
+#define HID_KEY_ARROW_LEFT 0x50
+#define HID_KEY_ARROW_DOWN 0x51
+#define HID_KEY_ARROW_UP 0x52
+
+#define MOUSE_BUTTON_LEFT (1u << 0)
+#define MOUSE_BUTTON_RIGHT (1u << 1)
+#define MOUSE_BUTTON_MIDDLE (1u << 2)
+
+#define GAMEPAD_BUTTON_A (1u << 0)
+#define GAMEPAD_BUTTON_B (1u << 1)
+
+typedef enum {
+  HID_REPORT_TYPE_INVALID = 0,
+  HID_REPORT_TYPE_INPUT,
+  HID_REPORT_TYPE_OUTPUT,
+  HID_REPORT_TYPE_FEATURE
+} hid_report_type_t;
+
+typedef struct __attribute__((packed)) {
+  uint8_t modifier;
+  uint8_t reserved;
+  uint8_t keycode[6];
+} hid_keyboard_report_t;
+
+typedef struct __attribute__((packed)) {
+  uint8_t buttons;
+  int8_t x;
+  int8_t y;
+  int8_t wheel;
+  int8_t pan;
+} hid_mouse_report_t;
+
+bool tud_init(uint8_t rhport);
+void tud_task(void);
+bool tud_task_event_ready(void);
+bool tud_mounted(void);
+bool tud_suspended(void);
+bool tud_remote_wakeup(void);
+
+bool tud_hid_n_ready(uint8_t instance);
+bool tud_hid_n_report(uint8_t instance, uint8_t report_id, const void *report, uint16_t len);
+bool tud_hid_n_keyboard_report(uint8_t instance, uint8_t report_id, uint8_t modifier, const uint8_t keycode[6]);
+bool tud_hid_n_mouse_report(uint8_t instance, uint8_t report_id,
+  uint8_t buttons, int8_t x, int8_t y, int8_t vertical, int8_t horizontal);
+
+// Callbacks implementados pelo firmware
+void tud_mount_cb(void);
+void tud_umount_cb(void);
+void tud_suspend_cb(bool remote_wakeup_en);
+void tud_resume_cb(void);
+void tud_hid_report_complete_cb(uint8_t instance, uint8_t const *report, uint16_t len);
+
+#endif
@@ -0,0 +1,448 @@
+// Implementação no host das funções do Pico SDK usadas pelo firmware.
+//
+// O tempo é um relógio virtual que só anda quando o firmware espera
+// (sleep, espera ativa, WFE) ou quando o barramento I2C está ocupado.
+// Alarmes e eventos da simulação disparam, em ordem, quando o relógio
+// passa do instante marcado. As escritas I2C, diretas ou por DMA, vão para
+// o emulador do SSD1306; o DMA do ADC lê os valores de host_adc_set.
+#include "pico_stubs.h"
+
+#include <string.h>
+
+#include "hardware/adc.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "hardware/flash.h"
+#include "hardware/i2c.h"
+#include "hardware/sync.h"
+#include "pico/multicore.h"
+#include "ssd1306_emulator.h"
+
+i2c_inst_t i2c0_inst;
+i2c_inst_t i2c1_inst;
+adc_hw_t host_adc_hw;
+uint8_t host_flash[PICO_FLASH_SIZE_BYTES];
+
+static uint64_t clock_us;
+
+// Relógio virtual e alarmes
+
+#define HOST_ALARMS 64
+
+static struct {
+  alarm_id_t id;
+  uint64_t time_us;
+  alarm_callback_t callback;
+  void *user_data;
+} alarms[HOST_ALARMS];
+static alarm_id_t next_alarm_id = 1;
+
+static void (*idle_hook)(void);
+
+absolute_time_t get_absolute_time(void) {
+  return clock_us;
+}
+
+uint32_t time_us_32(void) {
+  return (uint32_t)clock_us;
+}
+
+uint64_t time_us_64(void) {
+  return clock_us;
+}
+
+// Alarme ativo mais próximo; entre instantes iguais, o criado primeiro
+static int alarm_next(void) {
+  int next = -1;
+  for (int i = 0; i < HOST_ALARMS; ++i) {
+    if (!alarms[i].id) continue;
+    if (next < 0 || alarms[i].time_us < alarms[next].time_us ||
+        (alarms[i].time_us == alarms[next].time_us && alarms[i].id < alarms[next].id)) {
+      next = i;
+    }
+  }
+  return next;
+}
+
+uint64_t host_next_alarm_us(void) {
+  int next = alarm_next();
+  return next < 0 ? UINT64_MAX : alarms[next].time_us;
+}
+
+void host_run_until(uint64_t time_us) {
+  int next;
+  while ((next = alarm_next()) >= 0 && alarms[next].time_us <= time_us) {
+    if (alarms[next].time_us > clock_us) clock_us = alarms[next].time_us;
+
+    alarm_id_t id = alarms[next].id;
+    uint64_t scheduled = alarms[next].time_us;
+    alarm_callback_t callback = alarms[next].callback;
+    void *user_data = alarms[next].user_data;
+    alarms[next].id = 0;
+
+    // Retorno do callback como no SDK: 0 encerra, positivo reagenda a
+    // partir de agora e negativo a partir do instante marcado
+    int64_t again = callback(id, user_data);
+    if (again) {
+      uint64_t when = again > 0 ? clock_us + again : scheduled - again;
+      add_alarm_at(when, callback, user_data, true);
+    }
+  }
+  if (time_us > clock_us) clock_us = time_us;
+}
+
+void host_clock_advance_us(uint64_t us) {
+  host_run_until(clock_us + us);
+}
+
+void host_set_idle_hook(void (*hook)(void)) {
+  idle_hook = hook;
+}
+
+void host_tight_loop(void) {
+  host_clock_advance_us(1);
+  if (idle_hook) idle_hook();
+}
+
+alarm_id_t add_alarm_at(absolute_time_t time, alarm_callback_t callback, void *user_data, bool fire_if_past) {
+  if (time <= clock_us) {
+    if (!fire_if_past) return 0;
+    time = clock_us;
+  }
+  for (int i = 0; i < HOST_ALARMS; ++i) {
+    if (alarms[i].id) continue;
+    alarms[i].id = next_alarm_id++;
+    alarms[i].time_us = time;
+    alarms[i].callback = callback;
+    alarms[i].user_data = user_data;
+    return alarms[i].id;
+  }
+  return -1;
+}
+
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void *user_data, bool fire_if_past) {
+  return add_alarm_at(clock_us + us, callback, user_data, fire_if_past);
+}
+
+bool cancel_alarm(alarm_id_t id) {
+  for (int i = 0; i < HOST_ALARMS; ++i) {
+    if (id && alarms[i].id == id) {
+      alarms[i].id = 0;
+      return true;
+    }
+  }
+  return false;
+}
+
+void sleep_us(uint64_t us) {
+  host_clock_advance_us(us);
+}
+
+void sleep_ms(uint32_t ms) {
+  host_clock_advance_us((uint64_t)ms * 1000);
+}
+
+bool best_effort_wfe_or_timeout(absolute_time_t timeout) {
+  host_run_until(MIN(timeout, host_next_alarm_us()));
+  return clock_us >= timeout;
+}
+
+void __wfe(void) {
+  uint64_t next = host_next_alarm_us();
+  if (next != UINT64_MAX) host_run_until(next);
+}
+
+// GPIO: níveis dos pinos e interrupções de borda
+
+#define HOST_GPIOS 30
+
+static bool gpio_level[HOST_GPIOS];
+static bool gpio_driven[HOST_GPIOS];
+static uint32_t gpio_irq_mask[HOST_GPIOS];
+static gpio_irq_callback_t gpio_irq_callback;
+
+void gpio_init(uint gpio) {
+  (void)gpio;
+}
+
+void gpio_set_dir(uint gpio, bool out) {
+  (void)gpio;
+  (void)out;
+}
+
+void gpio_set_function(uint gpio, uint fn) {
+  (void)gpio;
+  (void)fn;
+}
+
+void gpio_pull_up(uint gpio) {
+  // Um pino não conduzido pela simulação fica em nível alto
+  if (gpio < HOST_GPIOS && !gpio_driven[gpio]) gpio_level[gpio] = true;
+}
+
+bool gpio_get(uint gpio) {
+  return gpio < HOST_GPIOS && gpio_level[gpio];
+}
+
+void gpio_set_irq_enabled(uint gpio, uint32_t event_mask, bool enabled) {
+  if (gpio >= HOST_GPIOS) return;
+  if (enabled) gpio_irq_mask[gpio] |= event_mask;
+  else gpio_irq_mask[gpio] &= ~event_mask;
+}
+
+void gpio_set_irq_enabled_with_callback(uint gpio, uint32_t event_mask, bool enabled, gpio_irq_callback_t callback) {
+  gpio_irq_callback = callback;
+  gpio_set_irq_enabled(gpio, event_mask, enabled);
+}
+
+void gpio_acknowledge_irq(uint gpio, uint32_t event_mask) {
+  (void)gpio;
+  (void)event_mask;
+}
+
+void host_gpio_set(uint gpio, bool level) {
+  if (gpio >= HOST_GPIOS) return;
+  bool previous = gpio_level[gpio];
+  gpio_driven[gpio] = true;
+  gpio_level[gpio] = level;
+  if (previous == level) return;
+
+  uint32_t event = level ? GPIO_IRQ_EDGE_RISE : GPIO_IRQ_EDGE_FALL;
+  if ((gpio_irq_mask[gpio] & event) && gpio_irq_callback) {
+    gpio_irq_callback(gpio, event);
+  }
+}
+
+// ADC: valores fixados pela simulação, lidos em round-robin
+
+#define HOST_ADC_INPUTS 5
+
+static uint16_t adc_value[HOST_ADC_INPUTS];
+// Valores mudaram desde o último preenchimento do anel
+static bool adc_changed = true;
+static uint adc_input;
+static uint adc_round_robin;
+
+void adc_init(void) {}
+
+void adc_gpio_init(uint gpio) {
+  (void)gpio;
+}
+
+void adc_select_input(uint input) {
+  adc_input = input;
+  adc_changed = true;
+}
+
+void adc_set_round_robin(uint input_mask) {
+  adc_round_robin = input_mask;
+}
+
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift) {
+  (void)en;
+  (void)dreq_en;
+  (void)dreq_thresh;
+  (void)err_in_fifo;
+  (void)byte_shift;
+}
+
+void adc_set_clkdiv(float clkdiv) {
+  (void)clkdiv;
+}
+
+void adc_run(bool run) {
+  (void)run;
+}
+
+void adc_fifo_drain(void) {}
+
+void host_adc_set(uint input, uint16_t value) {
+  if (input < HOST_ADC_INPUTS) adc_value[input] = value;
+  adc_changed = true;
+}
+
+// Entrada convertida depois de input, seguindo as entradas do round-robin
+// em ordem crescente
+static uint adc_round_robin_next(uint input) {
+  if (!adc_round_robin) return input;
+  do {
+    input = (input + 1) % HOST_ADC_INPUTS;
+  } while (!(adc_round_robin & (1u << input)));
+  return input;
+}
+
+// I2C
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate) {
+  // Barramento ocioso: FIFO de transmissão vazia
+  i2c->hw.status = I2C_IC_STATUS_TFE_BITS;
+  return i2c_set_baudrate(i2c, baudrate);
+}
+
+uint i2c_set_baudrate(i2c_inst_t *i2c, uint baudrate) {
+  i2c->baudrate = baudrate;
+  return baudrate;
+}
+
+// Tempo de uma transação: START, endereço e bytes de 9 bits (com ACK), STOP
+static uint64_t i2c_transaction_us(i2c_inst_t *i2c, size_t len) {
+  uint baudrate = i2c->baudrate ? i2c->baudrate : 100 * 1000;
+  uint64_t bits = (len + 1) * 9 + 2;
+  return (bits * 1000000 + baudrate - 1) / baudrate;
+}
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+  (void)nostop;
+  ssd1306_emulator_transaction(&emulator, addr, src, len);
+  host_clock_advance_us(i2c_transaction_us(i2c, len));
+  return (int)len;
+}
+
+// DMA
+
+#define HOST_DMA_CHANNELS 12
+
+static struct {
+  bool claimed;
+  dma_channel_config config;
+  volatile void *write_addr;
+  const volatile void *read_addr;
+  dma_channel_hw_t hw;
+  // Envio ao I2C: ocupado até este instante
+  uint64_t busy_until_us;
+  // Captura do ADC em andamento
+  bool capturing;
+} dma_channels[HOST_DMA_CHANNELS];
+
+int dma_claim_unused_channel(bool required) {
+  (void)required;
+  for (int channel = 0; channel < HOST_DMA_CHANNELS; ++channel) {
+    if (dma_channels[channel].claimed) continue;
+    dma_channels[channel].claimed = true;
+    return channel;
+  }
+  return -1;
+}
+
+dma_channel_config dma_channel_get_default_config(uint channel) {
+  (void)channel;
+  dma_channel_config config = { DMA_SIZE_32, true, false, 0, 0 };
+  return config;
+}
+
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size) {
+  c->size = size;
+}
+
+void channel_config_set_read_increment(dma_channel_config *c, bool incr) {
+  c->read_increment = incr;
+}
+
+void channel_config_set_write_increment(dma_channel_config *c, bool incr) {
+  c->write_increment = incr;
+}
+
+void channel_config_set_dreq(dma_channel_config *c, uint dreq) {
+  c->dreq = dreq;
+}
+
+void channel_config_set_ring(dma_channel_config *c, bool write, uint size_bits) {
+  (void)write;
+  c->ring_bits = size_bits;
+}
+
+void dma_channel_configure(uint channel, const dma_channel_config *config,
+  volatile void *write_addr, const volatile void *read_addr,
+  uint transfer_count, bool trigger
+) {
+  dma_channels[channel].config = *config;
+  dma_channels[channel].write_addr = write_addr;
+  dma_channels[channel].read_addr = read_addr;
+  if (trigger) dma_channel_transfer_from_buffer_now(channel, read_addr, transfer_count);
+}
+
+void dma_channel_transfer_from_buffer_now(uint channel, const volatile void *read_addr, uint32_t transfer_count) {
+  volatile void *write_addr = dma_channels[channel].write_addr;
+  i2c_inst_t *i2c = write_addr == &i2c0_inst.hw.data_cmd ? &i2c0_inst : &i2c1_inst;
+  if (write_addr != &i2c->hw.data_cmd) return;
+
+  // Cada palavra é um byte para a FIFO do I2C; o bit de STOP encerra a
+  // transação e o próximo byte abre outra. O emulador recebe tudo agora e
+  // o canal fica ocupado pelo tempo do barramento
+  const uint16_t *words = (const uint16_t *)read_addr;
+  uint8_t transaction[2048];
+  size_t len = 0;
+  uint64_t bus_us = 0;
+  for (uint32_t i = 0; i < transfer_count; ++i) {
+    if (len < sizeof(transaction)) transaction[len++] = words[i] & 0xFF;
+    if (words[i] & I2C_IC_DATA_CMD_STOP_BITS || i + 1 == transfer_count) {
+      ssd1306_emulator_transaction(&emulator, i2c->hw.tar, transaction, len);
+      bus_us += i2c_transaction_us(i2c, len);
+      len = 0;
+    }
+  }
+  dma_channels[channel].busy_until_us = clock_us + bus_us;
+}
+
+void dma_channel_transfer_to_buffer_now(uint channel, volatile void *write_addr, uint32_t transfer_count) {
+  (void)transfer_count;
+  dma_channels[channel].write_addr = write_addr;
+  dma_channels[channel].capturing = dma_channels[channel].config.dreq == DREQ_ADC;
+}
+
+dma_channel_hw_t *dma_channel_hw_addr(uint channel) {
+  // Captura do ADC: o anel inteiro recebe conversões novas e a próxima
+  // escrita volta ao início, então a amostra mais recente é a última. Só
+  // é preenchido de novo quando algum valor muda
+  if (dma_channels[channel].capturing && adc_changed) {
+    adc_changed = false;
+    volatile uint16_t *ring = dma_channels[channel].write_addr;
+    uint32_t samples = (1u << dma_channels[channel].config.ring_bits) / sizeof(uint16_t);
+    uint input = adc_input;
+    for (uint32_t i = 0; i < samples; ++i) {
+      ring[i] = adc_value[input];
+      input = adc_round_robin_next(input);
+    }
+    dma_channels[channel].hw.write_addr = (uint32_t)(uintptr_t)ring;
+  }
+  return &dma_channels[channel].hw;
+}
+
+bool dma_channel_is_busy(uint channel) {
+  return dma_channels[channel].capturing || clock_us < dma_channels[channel].busy_until_us;
+}
+
+void dma_channel_abort(uint channel) {
+  dma_channels[channel].capturing = false;
+  dma_channels[channel].busy_until_us = 0;
+}
+
+// Flash, clocks e segundo núcleo
+
+void flash_range_erase(uint32_t flash_offs, size_t count) {
+  memset(host_flash + flash_offs, 0xFF, count);
+}
+
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count) {
+  memcpy(host_flash + flash_offs, data, count);
+}
+
+static uint32_t sys_clock_hz = 125 * 1000 * 1000;
+
+uint32_t clock_get_hz(enum clock_index clk_index) {
+  return clk_index == clk_sys ? sys_clock_hz : 48 * 1000 * 1000;
+}
+
+bool set_sys_clock_khz(uint32_t freq_khz, bool required) {
+  (void)required;
+  sys_clock_hz = freq_khz * 1000;
+  return true;
+}
+
+void set_sys_clock_48mhz(void) {
+  sys_clock_hz = 48 * 1000 * 1000;
+}
+
+void multicore_launch_core1(void (*entry)(void)) {
+  (void)entry;
+}
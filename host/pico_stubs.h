@@ -0,0 +1,33 @@
+// Controle do ambiente simulado do Pico SDK e do TinyUSB no host
+#ifndef PICO_STUBS_H
+#define PICO_STUBS_H
+
+#include "pico/stdlib.h"
+
+// Avança o relógio virtual lido por get_absolute_time e time_us_*,
+// disparando no caminho os alarmes vencidos
+void host_clock_advance_us(uint64_t us);
+void host_run_until(uint64_t time_us);
+// Instante do próximo alarme, UINT64_MAX se não houver nenhum
+uint64_t host_next_alarm_us(void);
+
+// Tarefa do outro núcleo, executada a cada volta de uma espera ativa
+// (tight_loop_contents) para que quem espera por ele não trave
+void host_set_idle_hook(void (*hook)(void));
+
+// Entradas da placa simulada. Uma mudança de nível gera a interrupção de
+// borda habilitada no pino, como no RP2040
+void host_gpio_set(uint gpio, bool level);
+void host_adc_set(uint input, uint16_t value);
+void host_bootsel_set(bool pressed);
+
+// Computador simulado. O callback recebe cada relatório quando o
+// computador o lê do endpoint, com o instante em que o firmware o enviou
+typedef void (*host_hid_report_cb_t)(uint8_t instance, uint8_t report_id,
+  const uint8_t *report, uint16_t len, uint64_t sent_us);
+void host_usb_set_report_callback(host_hid_report_cb_t callback);
+// Suspende o barramento, permitindo ou não o remote wakeup, e retoma
+void host_usb_suspend(bool remote_wakeup_en);
+void host_usb_resume(void);
+
+#endif
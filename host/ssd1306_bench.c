@@ -0,0 +1,164 @@
+// Compara as primitivas de desenho do driver (máscaras por página e
+// memset) com as versões antigas, pixel a pixel: primeiro confere que as
+// duas desenham o mesmo buffer e marcam a mesma região suja, depois mede o
+// tempo de cada uma por chamada.
+//
+//   ssd1306_bench [repetições]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "pico_stubs.h"
+
+#include "../display/ssd1306.c"
+
+// Desenhos aleatórios da verificação
+#define BENCH_CHECKS 20000
+
+// Versões antigas das primitivas, um ssd1306_pixel por pixel
+static void reference_fill(ssd1306_t *ssd, bool value) {
+  for (uint8_t y = 0; y < ssd->height; ++y) {
+    for (uint8_t x = 0; x < ssd->width; ++x) {
+      ssd1306_pixel(ssd, x, y, value);
+    }
+  }
+}
+
+static void reference_rect(ssd1306_t *ssd,
+  uint8_t top, uint8_t left, uint8_t width, uint8_t height,
+  bool value, bool fill
+) {
+  for (uint8_t x = left; x < left + width; ++x) {
+    ssd1306_pixel(ssd, x, top, value);
+    ssd1306_pixel(ssd, x, top + height - 1, value);
+  }
+  for (uint8_t y = top; y < top + height; ++y) {
+    ssd1306_pixel(ssd, left, y, value);
+    ssd1306_pixel(ssd, left + width - 1, y, value);
+  }
+
+  if (fill) {
+    for (uint8_t x = left + 1; x < left + width - 1; ++x) {
+      for (uint8_t y = top + 1; y < top + height - 1; ++y) {
+        ssd1306_pixel(ssd, x, y, value);
+      }
+    }
+  }
+}
+
+static void reference_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value) {
+  for (uint8_t x = x0; x <= x1; ++x)
+    ssd1306_pixel(ssd, x, y, value);
+}
+
+static void reference_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
+  for (uint8_t y = y0; y <= y1; ++y)
+    ssd1306_pixel(ssd, x, y, value);
+}
+
+static ssd1306_t reference, fast;
+
+// Compara os buffers e as regiões sujas dos dois displays
+static bool bench_same(void) {
+  if (memcmp(reference.ram_buffer, fast.ram_buffer, fast.bufsize)) return false;
+  if (reference.dirty_pages != fast.dirty_pages) return false;
+  for (uint page = 0; page < fast.pages; ++page) {
+    if (!(fast.dirty_pages & (1 << page))) continue;
+    if (reference.dirty_x0[page] != fast.dirty_x0[page] ||
+        reference.dirty_x1[page] != fast.dirty_x1[page]) return false;
+  }
+  return true;
+}
+
+static void bench_clean(void) {
+  reference.dirty_pages = 0;
+  fast.dirty_pages = 0;
+}
+
+// Desenha a mesma primitiva aleatória nos dois displays. As coordenadas
+// passam da tela, mas ficam onde as versões antigas não dão a volta nos
+// contadores de 8 bits. Retângulos vazios ficam de fora: a versão antiga
+// desenhava a linha acima deles
+static bool bench_check(uint i) {
+  bool value = rand() & 1;
+  uint8_t a = rand() % 160, b = rand() % 96;
+  uint8_t c = 1 + rand() % (254 - a), d = 1 + rand() % (254 - b);
+
+  bench_clean();
+  switch (i % 5) {
+    case 0:
+      reference_fill(&reference, value);
+      ssd1306_fill(&fast, value);
+      break;
+    case 1:
+    case 2:
+      reference_rect(&reference, b, a, c, d, value, i % 5 == 1);
+      ssd1306_rect(&fast, b, a, c, d, value, i % 5 == 1);
+      break;
+    case 3:
+      reference_hline(&reference, a, a + c, b, value);
+      ssd1306_hline(&fast, a, a + c, b, value);
+      break;
+    default:
+      reference_vline(&reference, a, b, b + d, value);
+      ssd1306_vline(&fast, a, b, b + d, value);
+      break;
+  }
+  return bench_same();
+}
+
+static double bench_now_ns(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return now.tv_sec * 1e9 + now.tv_nsec;
+}
+
+// Tempo médio por chamada, em nanossegundos
+#define BENCH_TIME(result, repeats, call) do { \
+    double start = bench_now_ns(); \
+    for (uint n = 0; n < (repeats); ++n) { \
+      call; \
+      bench_clean(); \
+    } \
+    result = (bench_now_ns() - start) / (repeats); \
+  } while (0)
+
+#define BENCH(name, repeats, old_call, new_call) do { \
+    double old_ns, new_ns; \
+    BENCH_TIME(old_ns, repeats, old_call); \
+    BENCH_TIME(new_ns, repeats, new_call); \
+    printf("%-24s %10.0f %10.0f %8.1fx\n", name, old_ns, new_ns, old_ns / new_ns); \
+  } while (0)
+
+int main(int argc, char *argv[]) {
+  uint repeats = argc > 1 ? strtoul(argv[1], NULL, 10) : 20000;
+
+  ssd1306_init(&reference, WIDTH, HEIGHT, false, endereco, I2C_PORT);
+  ssd1306_init(&fast, WIDTH, HEIGHT, false, endereco, I2C_PORT);
+
+  srand(3);
+  for (uint i = 0; i < BENCH_CHECKS; ++i) {
+    if (!bench_check(i)) {
+      printf("desenho %u difere da versão pixel a pixel\n", i);
+      return 1;
+    }
+  }
+  printf("%u desenhos iguais aos da versão pixel a pixel\n\n", BENCH_CHECKS);
+
+  printf("%-24s %10s %10s %9s\n", "primitiva (ns/chamada)", "antes", "depois", "ganho");
+  BENCH("fill", repeats,
+    reference_fill(&reference, true), ssd1306_fill(&fast, true));
+  BENCH("rect cheio 120x56", repeats,
+    reference_rect(&reference, 4, 4, 120, 56, true, true),
+    ssd1306_rect(&fast, 4, 4, 120, 56, true, true));
+  BENCH("rect contorno 120x56", repeats,
+    reference_rect(&reference, 4, 4, 120, 56, true, false),
+    ssd1306_rect(&fast, 4, 4, 120, 56, true, false));
+  BENCH("hline 128", repeats,
+    reference_hline(&reference, 0, 127, 13, true), ssd1306_hline(&fast, 0, 127, 13, true));
+  BENCH("vline 64", repeats,
+    reference_vline(&reference, 13, 0, 63, true), ssd1306_vline(&fast, 13, 0, 63, true));
+  return 0;
+}
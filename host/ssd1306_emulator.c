@@ -0,0 +1,293 @@
+#include "ssd1306_emulator.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+ssd1306_emulator_t emulator;
+
+void ssd1306_emulator_init(ssd1306_emulator_t *emu) {
+  memset(emu, 0, sizeof(*emu));
+  // Valores de reset do controlador
+  emu->addressing_mode = 2;
+  emu->col_end = EMULATOR_WIDTH - 1;
+  emu->page_end = EMULATOR_PAGES - 1;
+  emu->contrast = 0x7F;
+}
+
+void ssd1306_emulator_reset_stats(ssd1306_emulator_t *emu) {
+  emu->transactions = 0;
+  emu->bytes = 0;
+  emu->command_bytes = 0;
+  emu->data_bytes = 0;
+}
+
+// Quantidade de argumentos que seguem cada comando
+static uint8_t command_arguments(uint8_t command) {
+  switch (command) {
+    case 0x20: // Modo de endereçamento
+    case 0x81: // Contraste
+    case 0x8D: // Bomba de carga
+    case 0xA8: // Multiplex
+    case 0xD3: // Deslocamento
+    case 0xD5: // Divisor do clock
+    case 0xD9: // Pré-carga
+    case 0xDA: // Pinos COM
+    case 0xDB: // Nível VCOMH
+      return 1;
+    case 0x21: // Janela de colunas
+    case 0x22: // Janela de páginas
+    case 0xA3: // Área de rolagem vertical
+      return 2;
+    case 0x29: // Rolagem vertical e horizontal
+    case 0x2A:
+      return 5;
+    case 0x26: // Rolagem horizontal
+    case 0x27:
+      return 6;
+    default:
+      return 0;
+  }
+}
+
+static void execute_command(ssd1306_emulator_t *emu) {
+  uint8_t command = emu->command;
+  const uint8_t *args = emu->args;
+
+  if (command <= 0x0F) {
+    emu->col = (emu->col & 0xF0) | command;
+  } else if (command <= 0x1F) {
+    emu->col = (emu->col & 0x0F) | ((command & 0x07) << 4);
+  } else if (command >= 0x40 && command <= 0x7F) {
+    emu->start_line = command & 0x3F;
+  } else if (command >= 0xB0 && command <= 0xB7) {
+    emu->page = command & 0x07;
+  } else {
+    switch (command) {
+      case 0x20: emu->addressing_mode = args[0] & 0x03; break;
+      case 0x21:
+        emu->col_start = args[0] & 0x7F;
+        emu->col_end = args[1] & 0x7F;
+        emu->col = emu->col_start;
+        break;
+      case 0x22:
+        emu->page_start = args[0] & 0x07;
+        emu->page_end = args[1] & 0x07;
+        emu->page = emu->page_start;
+        break;
+      case 0x2E: emu->scroll_active = false; break;
+      case 0x2F: emu->scroll_active = true; break;
+      case 0x81: emu->contrast = args[0]; break;
+      case 0xA0: emu->seg_remap = false; break;
+      case 0xA1: emu->seg_remap = true; break;
+      case 0xA4: emu->entire_on = false; break;
+      case 0xA5: emu->entire_on = true; break;
+      case 0xA6: emu->inverse = false; break;
+      case 0xA7: emu->inverse = true; break;
+      case 0xAE: emu->display_on = false; break;
+      case 0xAF: emu->display_on = true; break;
+      case 0xC0: emu->com_remap = false; break;
+      case 0xC8: emu->com_remap = true; break;
+      default: break;
+    }
+  }
+}
+
+static void write_command(ssd1306_emulator_t *emu, uint8_t byte) {
+  emu->command_bytes++;
+  if (emu->args_needed) {
+    emu->args[emu->args_count++] = byte;
+    if (emu->args_count < emu->args_needed) return;
+    emu->args_needed = 0;
+    execute_command(emu);
+    return;
+  }
+
+  emu->command = byte;
+  emu->args_count = 0;
+  emu->args_needed = command_arguments(byte);
+  if (!emu->args_needed) execute_command(emu);
+}
+
+static void write_data(ssd1306_emulator_t *emu, uint8_t byte) {
+  emu->data_bytes++;
+  emu->gddram[emu->page][emu->col] = byte;
+
+  switch (emu->addressing_mode) {
+    case 0: // Horizontal
+      if (emu->col++ >= emu->col_end) {
+        emu->col = emu->col_start;
+        emu->page = emu->page >= emu->page_end ? emu->page_start : emu->page + 1;
+      }
+      break;
+    case 1: // Vertical
+      if (emu->page++ >= emu->page_end) {
+        emu->page = emu->page_start;
+        emu->col = emu->col >= emu->col_end ? emu->col_start : emu->col + 1;
+      }
+      break;
+    default: // Páginas
+      emu->col = (emu->col + 1) % EMULATOR_WIDTH;
+      break;
+  }
+}
+
+void ssd1306_emulator_transaction(ssd1306_emulator_t *emu, 
+  uint8_t address, const uint8_t *bytes, size_t len
+) {
+  (void)address;
+  emu->transactions++;
+  // Endereço I2C + bytes escritos
+  emu->bytes += len + 1;
+
+  size_t i = 0;
+  while (i < len) {
+    uint8_t control = bytes[i++];
+    bool continuation = control & 0x80;
+    bool data = control & 0x40;
+
+    if (continuation) {
+      // Co = 1: um único byte antes do próximo byte de controle
+      if (i < len) {
+        if (data) write_data(emu, bytes[i++]);
+        else write_command(emu, bytes[i++]);
+      }
+    } else {
+      // Co = 0: o resto da transação é do mesmo tipo
+      while (i < len) {
+        if (data) write_data(emu, bytes[i++]);
+        else write_command(emu, bytes[i++]);
+      }
+    }
+  }
+}
+
+bool ssd1306_emulator_pixel(const ssd1306_emulator_t *emu, uint8_t x, uint8_t y) {
+  if (!emu->display_on) return false;
+  if (emu->entire_on) return true;
+
+  // O painel da BitDogLab é montado com segmentos e COM remapeados
+  // (0xA1, 0xC8); sem o remapeamento a imagem aparece espelhada
+  if (!emu->seg_remap) x = EMULATOR_WIDTH - 1 - x;
+  if (!emu->com_remap) y = EMULATOR_HEIGHT - 1 - y;
+  uint8_t row = (y + emu->start_line) % EMULATOR_HEIGHT;
+
+  bool value = (emu->gddram[row >> 3][x] >> (row & 0b111)) & 1;
+  return value != emu->inverse;
+}
+
+bool ssd1306_emulator_write_pbm(const ssd1306_emulator_t *emu, const char *path) {
+  FILE *out = fopen(path, "w");
+  if (!out) return false;
+
+  fprintf(out, "P1\n%d %d\n", EMULATOR_WIDTH, EMULATOR_HEIGHT);
+  for (uint8_t y = 0; y < EMULATOR_HEIGHT; ++y) {
+    for (uint8_t x = 0; x < EMULATOR_WIDTH; ++x) {
+      // No PBM, 1 é preto: pixels acesos ficam escuros no papel
+      fputc(ssd1306_emulator_pixel(emu, x, y) ? '1' : '0', out);
+    }
+    fputc('\n', out);
+  }
+  return fclose(out) == 0;
+}
+
+static uint32_t crc32_update(uint32_t crc, const uint8_t *data, size_t len) {
+  crc = ~crc;
+  for (size_t i = 0; i < len; ++i) {
+    crc ^= data[i];
+    for (int k = 0; k < 8; ++k) {
+      crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+    }
+  }
+  return ~crc;
+}
+
+static void write_u32(uint8_t *out, uint32_t value) {
+  out[0] = value >> 24;
+  out[1] = value >> 16;
+  out[2] = value >> 8;
+  out[3] = value;
+}
+
+static void write_chunk(FILE *out, const char *type, const uint8_t *data, size_t len) {
+  uint8_t header[8];
+  write_u32(header, len);
+  memcpy(header + 4, type, 4);
+  fwrite(header, 1, 8, out);
+  if (len) fwrite(data, 1, len, out);
+
+  uint32_t crc = crc32_update(0, header + 4, 4);
+  crc = crc32_update(crc, data, len);
+  uint8_t trailer[4];
+  write_u32(trailer, crc);
+  fwrite(trailer, 1, 4, out);
+}
+
+bool ssd1306_emulator_write_png(const ssd1306_emulator_t *emu, const char *path, uint8_t scale) {
+  if (!scale) scale = 1;
+  uint32_t width = EMULATOR_WIDTH * scale;
+  uint32_t height = EMULATOR_HEIGHT * scale;
+  size_t stride = width + 1;
+  size_t raw_len = stride * height;
+
+  // Imagem em tons de cinza de 8 bits, cada linha com o filtro 0 (nenhum)
+  uint8_t *raw = calloc(raw_len, 1);
+  if (!raw) return false;
+  for (uint32_t y = 0; y < height; ++y) {
+    uint8_t *row = raw + y * stride;
+    for (uint32_t x = 0; x < width; ++x) {
+      row[1 + x] = ssd1306_emulator_pixel(emu, x / scale, y / scale) ? 0xFF : 0x00;
+    }
+  }
+
+  // Fluxo zlib com blocos deflate sem compressão
+  size_t blocks = (raw_len + 0xFFFE) / 0xFFFF;
+  size_t zlib_len = 2 + blocks * 5 + raw_len + 4;
+  uint8_t *zlib = malloc(zlib_len);
+  if (!zlib) {
+    free(raw);
+    return false;
+  }
+  uint8_t *z = zlib;
+  *z++ = 0x78;
+  *z++ = 0x01;
+  uint32_t a = 1, b = 0;
+  for (size_t offset = 0; offset < raw_len; offset += 0xFFFF) {
+    uint16_t len = raw_len - offset > 0xFFFF ? 0xFFFF : raw_len - offset;
+    *z++ = offset + len == raw_len ? 1 : 0;
+    *z++ = len;
+    *z++ = len >> 8;
+    *z++ = ~len;
+    *z++ = (uint16_t)~len >> 8;
+    memcpy(z, raw + offset, len);
+    z += len;
+    for (uint16_t i = 0; i < len; ++i) {
+      a = (a + raw[offset + i]) % 65521;
+      b = (b + a) % 65521;
+    }
+  }
+  write_u32(z, (b << 16) | a);
+
+  FILE *out = fopen(path, "wb");
+  bool ok = out != NULL;
+  if (ok) {
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    uint8_t ihdr[13];
+    write_u32(ihdr, width);
+    write_u32(ihdr + 4, height);
+    ihdr[8] = 8;  // Bits por amostra
+    ihdr[9] = 0;  // Tons de cinza
+    ihdr[10] = 0; // Compressão deflate
+    ihdr[11] = 0; // Filtro padrão
+    ihdr[12] = 0; // Sem entrelaçamento
+    fwrite(signature, 1, sizeof(signature), out);
+    write_chunk(out, "IHDR", ihdr, sizeof(ihdr));
+    write_chunk(out, "IDAT", zlib, zlib_len);
+    write_chunk(out, "IEND", NULL, 0);
+    ok = fclose(out) == 0;
+  }
+
+  free(zlib);
+  free(raw);
+  return ok;
+}
@@ -0,0 +1,62 @@
+// Emulador do controlador SSD1306 para testes no host.
+//
+// Decodifica a sequência de bytes que o driver escreve no I2C (bytes de
+// controle, comandos e dados) em uma GDDRAM de 128x64, aplica o modo de
+// endereçamento, as janelas de colunas/páginas, o remapeamento e a linha
+// inicial, e conta transações e bytes para medir o custo de cada quadro.
+#ifndef SSD1306_EMULATOR_H
+#define SSD1306_EMULATOR_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define EMULATOR_WIDTH 128
+#define EMULATOR_HEIGHT 64
+#define EMULATOR_PAGES (EMULATOR_HEIGHT / 8)
+
+typedef struct {
+  // Memória do controlador, organizada em páginas como no SSD1306
+  uint8_t gddram[EMULATOR_PAGES][EMULATOR_WIDTH];
+
+  // Estado de endereçamento
+  uint8_t addressing_mode;
+  uint8_t col_start, col_end, col;
+  uint8_t page_start, page_end, page;
+
+  // Estado de exibição
+  bool display_on;
+  bool seg_remap;
+  bool com_remap;
+  bool inverse;
+  bool entire_on;
+  uint8_t start_line;
+  uint8_t contrast;
+  bool scroll_active;
+
+  // Comando em decodificação e seus argumentos
+  uint8_t command;
+  uint8_t args[8];
+  uint8_t args_needed, args_count;
+
+  // Estatísticas desde o último ssd1306_emulator_reset_stats
+  uint32_t transactions;
+  uint32_t bytes;
+  uint32_t command_bytes;
+  uint32_t data_bytes;
+} ssd1306_emulator_t;
+
+extern ssd1306_emulator_t emulator;
+
+void ssd1306_emulator_init(ssd1306_emulator_t *emu);
+void ssd1306_emulator_reset_stats(ssd1306_emulator_t *emu);
+// Processa uma transação I2C completa (START, endereço, bytes, STOP)
+void ssd1306_emulator_transaction(ssd1306_emulator_t *emu, 
+  uint8_t address, const uint8_t *bytes, size_t len
+);
+// Retorna o pixel visível na posição (x, y) do painel
+bool ssd1306_emulator_pixel(const ssd1306_emulator_t *emu, uint8_t x, uint8_t y);
+bool ssd1306_emulator_write_pbm(const ssd1306_emulator_t *emu, const char *path);
+bool ssd1306_emulator_write_png(const ssd1306_emulator_t *emu, const char *path, uint8_t scale);
+
+#endif
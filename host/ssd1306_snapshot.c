@@ -0,0 +1,91 @@
+// Desenha as telas do dispositivo no display emulado, salva cada uma como
+// PBM e PNG e mostra quantas transações e bytes cada envio gastou.
+//
+//   ssd1306_snapshot [diretório de saída]
+
+#include <stdio.h>
+#include <string.h>
+
+#include "pico_stubs.h"
+#include "ssd1306_emulator.h"
+
+#include "../display/ssd1306.c"
+#include "../display/console.c"
+
+static const char *output_dir = ".";
+
+static void snapshot(const char *name, uint64_t start_us) {
+  char path[256];
+
+  // Conclui o envio assíncrono, e o das mudanças que esperavam por ele,
+  // antes de ler o painel
+  ssd1306_wait(&ssd);
+  if (ssd1306_pending(&ssd)) {
+    display_task();
+    ssd1306_wait(&ssd);
+  }
+
+  snprintf(path, sizeof(path), "%s/%s.pbm", output_dir, name);
+  ssd1306_emulator_write_pbm(&emulator, path);
+  snprintf(path, sizeof(path), "%s/%s.png", output_dir, name);
+  ssd1306_emulator_write_png(&emulator, path, 4);
+
+  printf("%-14s %12u %8u %10u %9llu\n", 
+    name, emulator.transactions, emulator.bytes, emulator.data_bytes,
+    (unsigned long long)(time_us_64() - start_us));
+  ssd1306_emulator_reset_stats(&emulator);
+}
+
+int main(int argc, char *argv[]) {
+  if (argc > 1) output_dir = argv[1];
+  ssd1306_emulator_init(&emulator);
+
+  printf("%-14s %12s %8s %10s %9s\n", 
+    "tela", "transações", "bytes", "dados", "tempo_us");
+
+  uint64_t start = time_us_64();
+  setup_display_oled();
+  snapshot("boot", start);
+  printf("barramento: %u Hz, %u bytes/s medidos\n", ssd.bus_hz, display_bus_rate());
+
+  start = time_us_64();
+  print_hid_function("MOUSE");
+  snapshot("mouse", start);
+
+  start = time_us_64();
+  print_hid_function("TECLADO");
+  snapshot("teclado", start);
+
+  start = time_us_64();
+  display_draw_string("CARACTERE A", 8, 22);
+  display_send_data();
+  snapshot("caractere_a", start);
+
+  start = time_us_64();
+  display_draw_string("CARACTERE B", 8, 22);
+  display_send_data();
+  snapshot("caractere_b", start);
+
+  start = time_us_64();
+  print_hid_function("CONTROLE");
+  snapshot("controle", start);
+
+  // Console: depois de encher a tela, cada linha nova custa uma página
+  ssd1306_console_t console;
+  ssd1306_console_init(&console, &ssd);
+  display_send_data();
+  ssd1306_wait(&ssd);
+  ssd1306_emulator_reset_stats(&emulator);
+  for (int line = 1; line <= 10; ++line) {
+    char text[24];
+    char name[24];
+    snprintf(text, sizeof(text), "%sLINHA %d", line > 1 ? "\n" : "", line);
+    snprintf(name, sizeof(name), "console_%02d", line);
+    start = time_us_64();
+    ssd1306_console_write(&console, text);
+    display_send_data();
+    snapshot(name, start);
+  }
+
+  return 0;
+}
@@ -0,0 +1,185 @@
+// Implementação no host do TinyUSB e da placa usados pelo firmware. Um
+// computador simulado consulta cada endpoint HID a cada
+// HID_POLL_INTERVAL_MS: o relatório aceito por tud_hid_n_report ocupa o
+// endpoint até a próxima consulta, quando é entregue ao callback de
+// host_usb_set_report_callback e o firmware recebe
+// tud_hid_report_complete_cb na próxima tud_task.
+#include "pico_stubs.h"
+
+#include <string.h>
+
+#include "bsp/board_api.h"
+#include "hardware/flash.h"
+#include "tusb.h"
+#include "usb_descriptors.h"
+
+// Tempo que o computador leva para retomar o barramento depois de um
+// pedido de remote wakeup (o resume dura pelo menos 20 ms)
+#define HOST_USB_RESUME_US 20000
+
+#define HOST_REPORT_SIZE 16
+
+static struct {
+  bool busy;
+  bool complete;
+  uint8_t report_id;
+  uint8_t report[HOST_REPORT_SIZE];
+  uint16_t len;
+  uint64_t sent_us;
+} endpoints[HID_ITF_COUNT];
+
+static bool mounted;
+static bool suspended;
+static bool remote_wakeup_enabled;
+// Eventos do barramento esperando a próxima tud_task
+static bool mount_pending, suspend_pending, resume_pending;
+
+static host_hid_report_cb_t report_callback;
+
+static bool led_state;
+static bool bootsel_pressed;
+
+void host_usb_set_report_callback(host_hid_report_cb_t callback) {
+  report_callback = callback;
+}
+
+bool tud_init(uint8_t rhport) {
+  (void)rhport;
+  // O computador enumera o dispositivo logo na primeira tud_task
+  mount_pending = true;
+  return true;
+}
+
+bool tud_task_event_ready(void) {
+  if (mount_pending || suspend_pending || resume_pending) return true;
+  for (uint i = 0; i < HID_ITF_COUNT; ++i) {
+    if (endpoints[i].complete) return true;
+  }
+  return false;
+}
+
+void tud_task(void) {
+  if (mount_pending) {
+    mount_pending = false;
+    mounted = true;
+    tud_mount_cb();
+  }
+  if (suspend_pending) {
+    suspend_pending = false;
+    tud_suspend_cb(remote_wakeup_enabled);
+  }
+  if (resume_pending) {
+    resume_pending = false;
+    tud_resume_cb();
+  }
+  for (uint i = 0; i < HID_ITF_COUNT; ++i) {
+    if (!endpoints[i].complete) continue;
+    endpoints[i].complete = false;
+    endpoints[i].busy = false;
+    tud_hid_report_complete_cb(i, endpoints[i].report, endpoints[i].len);
+  }
+}
+
+bool tud_mounted(void) {
+  return mounted;
+}
+
+bool tud_suspended(void) {
+  return suspended;
+}
+
+void host_usb_suspend(bool remote_wakeup_en) {
+  if (suspended) return;
+  suspended = true;
+  remote_wakeup_enabled = remote_wakeup_en;
+  suspend_pending = true;
+}
+
+void host_usb_resume(void) {
+  if (!suspended) return;
+  suspended = false;
+  resume_pending = true;
+}
+
+static int64_t usb_resume_alarm(alarm_id_t id, void *user_data) {
+  (void)id;
+  (void)user_data;
+  host_usb_resume();
+  return 0;
+}
+
+bool tud_remote_wakeup(void) {
+  if (!suspended || !remote_wakeup_enabled) return false;
+  add_alarm_in_us(HOST_USB_RESUME_US, usb_resume_alarm, NULL, true);
+  return true;
+}
+
+bool tud_hid_n_ready(uint8_t instance) {
+  return instance < HID_ITF_COUNT && mounted && !suspended && !endpoints[instance].busy;
+}
+
+// Consulta do computador ao endpoint: o relatório é recebido
+static int64_t usb_poll_alarm(alarm_id_t id, void *user_data) {
+  (void)id;
+  uint instance = (uint)(uintptr_t)user_data;
+  if (report_callback) {
+    report_callback(instance, endpoints[instance].report_id,
+      endpoints[instance].report, endpoints[instance].len, endpoints[instance].sent_us);
+  }
+  endpoints[instance].complete = true;
+  return 0;
+}
+
+bool tud_hid_n_report(uint8_t instance, uint8_t report_id, const void *report, uint16_t len) {
+  if (!tud_hid_n_ready(instance) || len > HOST_REPORT_SIZE) return false;
+
+  endpoints[instance].busy = true;
+  endpoints[instance].report_id = report_id;
+  memcpy(endpoints[instance].report, report, len);
+  endpoints[instance].len = len;
+  endpoints[instance].sent_us = time_us_64();
+
+  // A próxima consulta é no início do próximo intervalo
+  uint64_t interval_us = HID_POLL_INTERVAL_MS * 1000;
+  uint64_t poll_us = (time_us_64() / interval_us + 1) * interval_us;
+  add_alarm_at(poll_us, usb_poll_alarm, (void *)(uintptr_t)instance, true);
+  return true;
+}
+
+bool tud_hid_n_keyboard_report(uint8_t instance, uint8_t report_id, uint8_t modifier, const uint8_t keycode[6]) {
+  hid_keyboard_report_t report = { .modifier = modifier };
+  if (keycode) memcpy(report.keycode, keycode, sizeof(report.keycode));
+  return tud_hid_n_report(instance, report_id, &report, sizeof(report));
+}
+
+bool tud_hid_n_mouse_report(uint8_t instance, uint8_t report_id,
+  uint8_t buttons, int8_t x, int8_t y, int8_t vertical, int8_t horizontal
+) {
+  hid_mouse_report_t report = {
+    .buttons = buttons, .x = x, .y = y, .wheel = vertical, .pan = horizontal
+  };
+  return tud_hid_n_report(instance, report_id, &report, sizeof(report));
+}
+
+// Placa
+
+void board_init(void) {
+  // Flash apagada: sem calibração gravada
+  memset(host_flash, 0xFF, sizeof(host_flash));
+}
+
+void board_led_write(bool state) {
+  led_state = state;
+}
+
+uint32_t board_button_read(void) {
+  return bootsel_pressed;
+}
+
+uint32_t board_millis(void) {
+  return (uint32_t)(time_us_64() / 1000);
+}
+
+void host_bootsel_set(bool pressed) {
+  bootsel_pressed = pressed;
+}
@@ -0,0 +1,164 @@
+#include "hardware/flash.h"
+#include "hardware/sync.h"
+
+// Calibração do joystick: centro em repouso, extremos de cada eixo e zona
+// morta derivada do ruído medido em repouso. Fica gravada no último setor
+// da flash e é carregada na inicialização sem precisar medir de novo.
+
+// Posição normalizada de cada eixo vai de -JOYSTICK_SCALE a +JOYSTICK_SCALE
+#define JOYSTICK_SCALE 2048
+
+// Valores usados antes de qualquer calibração
+#define JOYSTICK_ADC_MAX 4095
+#define JOYSTICK_DEFAULT_DEADZONE 96
+
+// Folga somada à maior variação medida em repouso
+#define JOYSTICK_DEADZONE_MARGIN 16
+// Duração das medições, em milissegundos
+#define JOYSTICK_REST_MS 500
+#define JOYSTICK_RANGE_MS 4000
+
+// Setor da flash reservado para a calibração: o último do chip
+#define JOYSTICK_CALIBRATION_OFFSET (PICO_FLASH_SIZE_BYTES - FLASH_SECTOR_SIZE)
+#define JOYSTICK_CALIBRATION_MAGIC 0x4A4F5943 // "JOYC"
+#define JOYSTICK_CALIBRATION_VERSION 1
+
+typedef struct {
+  uint16_t center;
+  uint16_t min;
+  uint16_t max;
+  uint16_t deadzone;
+} joystick_axis_calibration_t;
+
+typedef struct {
+  uint32_t magic;
+  uint32_t version;
+  joystick_axis_calibration_t x;
+  joystick_axis_calibration_t y;
+  uint32_t checksum;
+} joystick_calibration_t;
+
+static joystick_calibration_t joystick_calibration = {
+  .x = { JOYSTICK_MIDDLE_X, 0, JOYSTICK_ADC_MAX, JOYSTICK_DEFAULT_DEADZONE },
+  .y = { JOYSTICK_MIDDLE_Y, 0, JOYSTICK_ADC_MAX, JOYSTICK_DEFAULT_DEADZONE },
+};
+
+static uint32_t joystick_calibration_checksum(const joystick_calibration_t *calibration) {
+  const uint8_t *bytes = (const uint8_t *)calibration;
+  uint32_t checksum = 0x811C9DC5;
+  for (size_t i = 0; i < offsetof(joystick_calibration_t, checksum); ++i) {
+    checksum = (checksum ^ bytes[i]) * 0x01000193;
+  }
+  return checksum;
+}
+
+// Carrega a calibração gravada na flash. Retorna false se não houver uma
+// válida, mantendo os valores atuais
+bool joystick_calibration_load() {
+  const joystick_calibration_t *stored = 
+    (const joystick_calibration_t *)(XIP_BASE + JOYSTICK_CALIBRATION_OFFSET);
+  if (stored->magic != JOYSTICK_CALIBRATION_MAGIC ||
+      stored->version != JOYSTICK_CALIBRATION_VERSION ||
+      stored->checksum != joystick_calibration_checksum(stored)) {
+    return false;
+  }
+  joystick_calibration = *stored;
+  return true;
+}
+
+// Grava a calibração atual na flash. Deve ser chamada antes de iniciar o
+// USB: as interrupções ficam desligadas enquanto o setor é apagado e gravado
+void joystick_calibration_save() {
+  joystick_calibration.magic = JOYSTICK_CALIBRATION_MAGIC;
+  joystick_calibration.version = JOYSTICK_CALIBRATION_VERSION;
+  joystick_calibration.checksum = joystick_calibration_checksum(&joystick_calibration);
+
+  uint8_t page[FLASH_PAGE_SIZE];
+  memset(page, 0xFF, sizeof(page));
+  memcpy(page, &joystick_calibration, sizeof(joystick_calibration));
+
+  uint32_t interrupts = save_and_disable_interrupts();
+  flash_range_erase(JOYSTICK_CALIBRATION_OFFSET, FLASH_SECTOR_SIZE);
+  flash_range_program(JOYSTICK_CALIBRATION_OFFSET, page, FLASH_PAGE_SIZE);
+  restore_interrupts(interrupts);
+}
+
+// Mede o joystick em repouso: o centro é a média das leituras e a zona
+// morta cobre a maior variação observada em torno dele
+void joystick_calibrate_rest() {
+  uint32_t sum_x = 0, sum_y = 0, samples = 0;
+  uint16_t low_x = JOYSTICK_ADC_MAX, high_x = 0;
+  uint16_t low_y = JOYSTICK_ADC_MAX, high_y = 0;
+
+  for (uint32_t ms = 0; ms < JOYSTICK_REST_MS; ++ms) {
+    sleep_ms(1);
+    uint16_t x = read_X();
+    uint16_t y = read_Y();
+    sum_x += x;
+    sum_y += y;
+    samples++;
+    if (x < low_x) low_x = x;
+    if (x > high_x) high_x = x;
+    if (y < low_y) low_y = y;
+    if (y > high_y) high_y = y;
+  }
+
+  joystick_axis_calibration_t *cx = &joystick_calibration.x;
+  joystick_axis_calibration_t *cy = &joystick_calibration.y;
+  cx->center = sum_x / samples;
+  cy->center = sum_y / samples;
+  uint16_t spread_x = high_x - cx->center > cx->center - low_x ? high_x - cx->center : cx->center - low_x;
+  uint16_t spread_y = high_y - cy->center > cy->center - low_y ? high_y - cy->center : cy->center - low_y;
+  cx->deadzone = spread_x + JOYSTICK_DEADZONE_MARGIN;
+  cy->deadzone = spread_y + JOYSTICK_DEADZONE_MARGIN;
+}
+
+// Mede os extremos de cada eixo enquanto o usuário gira o joystick
+void joystick_calibrate_range() {
+  joystick_axis_calibration_t *cx = &joystick_calibration.x;
+  joystick_axis_calibration_t *cy = &joystick_calibration.y;
+  cx->min = cx->max = cx->center;
+  cy->min = cy->max = cy->center;
+
+  for (uint32_t ms = 0; ms < JOYSTICK_RANGE_MS; ++ms) {
+    sleep_ms(1);
+    uint16_t x = read_X();
+    uint16_t y = read_Y();
+    if (x < cx->min) cx->min = x;
+    if (x > cx->max) cx->max = x;
+    if (y < cy->min) cy->min = y;
+    if (y > cy->max) cy->max = y;
+  }
+}
+
+// Converte a leitura do ADC na posição do eixo, de -JOYSTICK_SCALE a
+// +JOYSTICK_SCALE. Dentro da zona morta a posição é 0, e fora dela cresce
+// a partir de 0 até o extremo medido de cada lado
+static int16_t joystick_axis_position(const joystick_axis_calibration_t *axis, uint16_t value) {
+  int32_t offset = (int32_t)value - axis->center;
+  int32_t span;
+
+  if (offset > axis->deadzone) {
+    offset -= axis->deadzone;
+    span = (int32_t)axis->max - axis->center - axis->deadzone;
+  } else if (offset < -(int32_t)axis->deadzone) {
+    offset += axis->deadzone;
+    span = (int32_t)axis->center - axis->min - axis->deadzone;
+  } else {
+    return 0;
+  }
+
+  if (span <= 0) return offset > 0 ? JOYSTICK_SCALE : -JOYSTICK_SCALE;
+  int32_t position = offset * JOYSTICK_SCALE / span;
+  if (position > JOYSTICK_SCALE) position = JOYSTICK_SCALE;
+  if (position < -JOYSTICK_SCALE) position = -JOYSTICK_SCALE;
+  return position;
+}
+
+int16_t joystick_position_x() {
+  return joystick_axis_position(&joystick_calibration.x, read_X());
+}
+
+int16_t joystick_position_y() {
+  return joystick_axis_position(&joystick_calibration.y, read_Y());
+}
@@ -0,0 +1,151 @@
+// Filtro de tremor do joystick ("one euro" em ponto fixo). Cada eixo passa
+// por um passa-baixas de primeira ordem cuja frequência de corte cresce com
+// a velocidade do movimento: parado, o corte baixo remove o tremor; em
+// movimento rápido, o corte alto quase não atrasa a posição.
+//
+// O filtro roda a uma taxa fixa, o que permite calcular os coeficientes só
+// com aritmética inteira de 32 bits e divisões do divisor em hardware
+
+// Passos do filtro por segundo
+#define JOYSTICK_FILTER_RATE JOYSTICK_SAMPLE_RATE
+// Maior atraso tolerado até recomeçar a contagem dos passos, em passos
+#define JOYSTICK_FILTER_MAX_CATCHUP 8
+// Frequência de corte máxima, em mHz. Acima da taxa do filtro o
+// passa-baixas praticamente copia a leitura; o limite mantém os cálculos
+// em 32 bits
+#define JOYSTICK_FILTER_MAX_CUTOFF 4000000
+// Intervalo entre passos com os dois eixos em repouso, em us. Parado na
+// zona morta, o filtro não muda e o laço principal não precisa acordar a
+// cada passo; em troca, um movimento a partir do centro pode levar até
+// esse intervalo a mais para ser lido
+#define JOYSTICK_FILTER_IDLE_US 10000
+// Bits fracionários da posição e da velocidade filtradas. Com menos bits,
+// os passos do passa-baixas de corte baixo arredondam para zero e a
+// velocidade do tremor não chega à estimativa
+#define JOYSTICK_FILTER_FRACTION 16
+
+// Parâmetros de um perfil. Frequências em mHz; beta em mHz somados ao corte
+// para cada 1000 unidades de posição por segundo
+typedef struct {
+  uint32_t min_cutoff;
+  uint32_t beta;
+  uint32_t derivative_cutoff;
+} joystick_filter_profile_t;
+
+typedef struct {
+  int32_t position;   // posição filtrada, com JOYSTICK_FILTER_FRACTION bits
+  int32_t derivative; // variação filtrada por passo, mesma escala
+  int32_t previous;   // última leitura, mesma escala
+  bool started;
+} joystick_filter_axis_t;
+
+static struct {
+  joystick_filter_axis_t x;
+  joystick_filter_axis_t y;
+  uint64_t next_us;
+  // Instante da última leitura do joystick
+  uint32_t sample_us;
+} joystick_filter;
+
+// Coeficiente do passa-baixas, em Q16, para a frequência de corte dada:
+// alpha = w / (1 + w) = 1 - 1 / (1 + w), com w = 2 * pi * corte / taxa.
+// Na segunda forma, 2^32 / (2^16 + w) cabe em 32 bits para qualquer w
+static uint32_t joystick_filter_alpha(uint32_t cutoff) {
+  if (cutoff > JOYSTICK_FILTER_MAX_CUTOFF) cutoff = JOYSTICK_FILTER_MAX_CUTOFF;
+  // 2 * pi * 65536 / 1000 = 411,77: w em Q16 com o corte em mHz
+  uint32_t w = cutoff * 412 / JOYSTICK_FILTER_RATE;
+  return (1 << 16) - UINT32_MAX / ((1 << 16) + w);
+}
+
+static inline int32_t joystick_filter_lowpass(int32_t previous, int32_t value, uint32_t alpha) {
+  return previous + (int32_t)(((int64_t)(value - previous) * alpha) >> 16);
+}
+
+// Aplica um passo do filtro a um eixo e retorna a posição filtrada
+static int16_t joystick_filter_axis(
+  joystick_filter_axis_t *axis, const joystick_filter_profile_t *profile, int16_t value
+) {
+  int32_t position = (int32_t)value << JOYSTICK_FILTER_FRACTION;
+
+  if (!axis->started) {
+    axis->position = position;
+    axis->derivative = 0;
+    axis->previous = position;
+    axis->started = true;
+    return value;
+  }
+
+  // Velocidade estimada, suavizada para o ruído não abrir o corte
+  axis->derivative = joystick_filter_lowpass(
+    axis->derivative, position - axis->previous,
+    joystick_filter_alpha(profile->derivative_cutoff)
+  );
+  axis->previous = position;
+
+  // Unidades de posição por segundo
+  uint32_t speed = (uint64_t)abs(axis->derivative) * JOYSTICK_FILTER_RATE
+    >> JOYSTICK_FILTER_FRACTION;
+  uint32_t cutoff = JOYSTICK_FILTER_MAX_CUTOFF;
+  if (profile->beta == 0 || speed < (JOYSTICK_FILTER_MAX_CUTOFF / profile->beta) * 1000) {
+    cutoff = profile->min_cutoff + profile->beta * speed / 1000;
+  }
+
+  axis->position = joystick_filter_lowpass(
+    axis->position, position, joystick_filter_alpha(cutoff)
+  );
+  return axis->position >> JOYSTICK_FILTER_FRACTION;
+}
+
+// Com a última leitura na zona morta e a posição filtrada a menos de uma
+// unidade do centro, leva o eixo direto ao repouso. Retorna true se o eixo
+// está em repouso
+static bool joystick_filter_axis_settle(joystick_filter_axis_t *axis) {
+  if (axis->previous != 0 || abs(axis->position) >= 1 << JOYSTICK_FILTER_FRACTION) {
+    return false;
+  }
+  axis->position = 0;
+  axis->derivative = 0;
+  return true;
+}
+
+// Executa os passos do filtro devidos até o instante atual sobre a posição
+// calibrada do joystick. Deve ser chamada a cada volta do laço principal;
+// se ele atrasar demais, os passos perdidos são descartados em vez de
+// aplicados de uma vez. Com os dois eixos em repouso, o próximo passo fica
+// para daqui a JOYSTICK_FILTER_IDLE_US
+void joystick_filter_task(const joystick_filter_profile_t *profile) {
+  const uint64_t period_us = 1000000 / JOYSTICK_FILTER_RATE;
+  uint64_t now = time_us_64();
+
+  if (now < joystick_filter.next_us) return;
+  if (now - joystick_filter.next_us > JOYSTICK_FILTER_MAX_CATCHUP * period_us) {
+    joystick_filter.next_us = now;
+  }
+
+  int16_t x = joystick_position_x();
+  int16_t y = joystick_position_y();
+  joystick_filter.sample_us = now;
+  while (joystick_filter.next_us <= now) {
+    joystick_filter_axis(&joystick_filter.x, profile, x);
+    joystick_filter_axis(&joystick_filter.y, profile, y);
+    joystick_filter.next_us += period_us;
+  }
+
+  bool settled_x = joystick_filter_axis_settle(&joystick_filter.x);
+  bool settled_y = joystick_filter_axis_settle(&joystick_filter.y);
+  if (settled_x && settled_y) joystick_filter.next_us = now + JOYSTICK_FILTER_IDLE_US;
+}
+
+// Posição filtrada de cada eixo, de -JOYSTICK_SCALE a +JOYSTICK_SCALE
+int16_t joystick_filtered_x() {
+  return joystick_filter.x.position >> JOYSTICK_FILTER_FRACTION;
+}
+
+int16_t joystick_filtered_y() {
+  return joystick_filter.y.position >> JOYSTICK_FILTER_FRACTION;
+}
+
+// Instante da leitura que gerou a posição filtrada atual
+uint32_t joystick_filtered_time() {
+  return joystick_filter.sample_us;
+}
@@ -1,3 +1,6 @@
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+
 // GPIO para eixo X
 #define JOYSTICK_X_PIN 27 
 // GPIO para eixo Y
@@ -10,6 +13,48 @@
 // Valor em repouso do eixo y
 #define JOYSTICK_MIDDLE_Y 1997
 
+// Entradas do ADC de cada eixo (GPIO 26 = ADC0, GPIO 27 = ADC1)
+#define JOYSTICK_Y_INPUT 0
+#define JOYSTICK_X_INPUT 1
+
+// Amostras por segundo de cada eixo. O ADC alterna entre os dois eixos
+// sozinho (round-robin), a 48 MHz / (1 + divisor) conversões por segundo
+#define JOYSTICK_SAMPLE_RATE 1000
+#define JOYSTICK_ADC_CLKDIV (48000000 / (2 * JOYSTICK_SAMPLE_RATE) - 1)
+
+// Buffer circular preenchido pelo DMA: as amostras se alternam entre Y
+// (posições pares) e X (posições ímpares). O tamanho em bytes precisa ser
+// potência de 2 e o buffer alinhado a ele para o anel do DMA
+#define JOYSTICK_RING_BITS 7
+#define JOYSTICK_RING_SIZE ((1 << JOYSTICK_RING_BITS) / sizeof(uint16_t))
+
+// Amostras somadas em cada leitura de eixo (sobreamostragem)
+#define JOYSTICK_OVERSAMPLE 4
+
+static volatile uint16_t joystick_ring[JOYSTICK_RING_SIZE]
+  __attribute__((aligned(1 << JOYSTICK_RING_BITS)));
+static int joystick_dma_channel;
+
+// Inicia as conversões a partir do eixo Y, com o DMA escrevendo no começo
+// do anel, para que as posições pares continuem sendo do eixo Y. O DMA
+// recebe a maior contagem possível; o anel faz o endereço de escrita
+// voltar ao início do buffer sozinho
+static void joystick_sampling_start() {
+  adc_run(false);
+  adc_fifo_drain();
+  adc_select_input(JOYSTICK_Y_INPUT);
+  dma_channel_transfer_to_buffer_now(joystick_dma_channel, joystick_ring, 0xFFFFFFFF);
+  adc_run(true);
+}
+
+// Para as conversões e o DMA, para economizar energia com o USB suspenso.
+// joystick_sampling_start volta a capturar
+static void joystick_sampling_stop() {
+  adc_run(false);
+  dma_channel_abort(joystick_dma_channel);
+  adc_fifo_drain();
+}
+
 void setup_joystick() {
     adc_init();
     adc_gpio_init(JOYSTICK_X_PIN);
@@ -18,14 +63,55 @@ void setup_joystick() {
     gpio_init(JOYSTICK_BUTTON);
     gpio_set_dir(JOYSTICK_BUTTON, GPIO_IN);
     gpio_pull_up(JOYSTICK_BUTTON); 
+
+    // Conversões contínuas alternando Y e X
+    adc_set_round_robin((1 << JOYSTICK_Y_INPUT) | (1 << JOYSTICK_X_INPUT));
+    // FIFO habilitada, pedindo DMA a cada amostra, sem bit de erro nem
+    // redução para 8 bits
+    adc_fifo_setup(true, true, 1, false, false);
+    adc_set_clkdiv(JOYSTICK_ADC_CLKDIV);
+
+    joystick_dma_channel = dma_claim_unused_channel(true);
+    dma_channel_config config = dma_channel_get_default_config(joystick_dma_channel);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_16);
+    channel_config_set_read_increment(&config, false);
+    channel_config_set_write_increment(&config, true);
+    channel_config_set_ring(&config, true, JOYSTICK_RING_BITS);
+    channel_config_set_dreq(&config, DREQ_ADC);
+    dma_channel_configure(
+      joystick_dma_channel, &config, joystick_ring, &adc_hw->fifo, 0, false
+    );
+    joystick_sampling_start();
+}
+
+// Lê a média das últimas amostras de um eixo, sem esperar o ADC
+static uint16_t joystick_read_axis(uint input) {
+    // Depois de semanas a contagem do DMA chega ao fim: recomeça a captura
+    if (!dma_channel_is_busy(joystick_dma_channel)) {
+      joystick_sampling_start();
+    }
+
+    // Posição da próxima escrita do DMA no anel
+    uint32_t write_addr = dma_channel_hw_addr(joystick_dma_channel)->write_addr;
+    uint32_t next = (write_addr - (uint32_t)(uintptr_t)joystick_ring) / sizeof(uint16_t);
+
+    // Amostra mais recente do eixo: posições pares são Y, ímpares são X
+    uint32_t newest = (next - 1) % JOYSTICK_RING_SIZE;
+    if ((newest & 1) != input) {
+      newest = (newest - 1) % JOYSTICK_RING_SIZE;
+    }
+
+    uint32_t sum = 0;
+    for (uint i = 0; i < JOYSTICK_OVERSAMPLE; ++i) {
+      sum += joystick_ring[(newest - 2 * i) % JOYSTICK_RING_SIZE];
+    }
+    return sum / JOYSTICK_OVERSAMPLE;
 }
 
 uint16_t read_Y() {
-    adc_select_input(0); 
-    return adc_read();
+    return joystick_read_axis(JOYSTICK_Y_INPUT);
 }
 
 uint16_t read_X() {
-    adc_select_input(1); 
-    return adc_read();
+    return joystick_read_axis(JOYSTICK_X_INPUT);
 }
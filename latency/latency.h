@@ -0,0 +1,133 @@
+// Medição da latência de ponta a ponta de cada função. Cada relatório HID
+// que leva uma entrada (borda de um botão ou leitura do joystick) guarda o
+// instante dessa entrada e o instante em que foi montado; quando o USB
+// confirma a entrega ao computador (tud_hid_report_complete_cb), as três
+// marcas vão para histogramas de faixas fixas.
+//
+// As faixas dobram de tamanho: a primeira vai até 256 us, a segunda até
+// 512 us e assim por diante; a última recebe tudo acima de 2^18 us (262 ms)
+
+#include <stdio.h>
+
+// Funções acompanhadas
+#define LATENCY_MODES 4
+// Interfaces HID, cada uma com um relatório em trânsito
+#define LATENCY_INSTANCES 3
+#define LATENCY_BUCKETS 12
+// Limite superior da primeira faixa, como potência de 2 em microssegundos
+#define LATENCY_FIRST_BUCKET_BITS 8
+
+typedef enum {
+  // Da entrada até o relatório ser montado
+  LATENCY_INPUT_TO_REPORT,
+  // Do relatório montado até o computador recebê-lo
+  LATENCY_REPORT_TO_HOST,
+  // Da entrada até o computador receber o relatório
+  LATENCY_INPUT_TO_HOST,
+  LATENCY_STAGES
+} latency_stage_t;
+
+typedef struct {
+  uint32_t buckets[LATENCY_BUCKETS];
+  uint32_t count;
+  uint32_t max_us;
+  uint64_t sum_us;
+} latency_histogram_t;
+
+static const char *latency_stage_names[LATENCY_STAGES] = {
+  "entrada-relatorio", "relatorio-host", "entrada-host"
+};
+
+static latency_histogram_t latency_histograms[LATENCY_MODES][LATENCY_STAGES];
+
+// Relatório em trânsito em cada interface: o USB entrega um relatório por
+// vez em cada endpoint
+static struct {
+  bool valid;
+  uint mode;
+  uint32_t input_us;
+  uint32_t report_us;
+} latency_in_flight[LATENCY_INSTANCES];
+
+static uint latency_bucket(uint32_t us) {
+  uint32_t scaled = us >> LATENCY_FIRST_BUCKET_BITS;
+  uint bucket = scaled ? 32 - __builtin_clz(scaled) : 0;
+  return bucket < LATENCY_BUCKETS ? bucket : LATENCY_BUCKETS - 1;
+}
+
+static void latency_record(latency_histogram_t *histogram, uint32_t us) {
+  histogram->buckets[latency_bucket(us)]++;
+  histogram->count++;
+  histogram->sum_us += us;
+  if (us > histogram->max_us) histogram->max_us = us;
+}
+
+// Marca um relatório recém-entregue ao USB na interface instance, gerado
+// pela entrada em input_us
+void latency_report_sent(uint instance, uint mode, uint32_t input_us) {
+  latency_in_flight[instance].mode = mode;
+  latency_in_flight[instance].input_us = input_us;
+  latency_in_flight[instance].report_us = time_us_32();
+  latency_in_flight[instance].valid = true;
+}
+
+// Fecha a medição do relatório em trânsito na interface. Chamada quando o
+// computador confirma o recebimento; relatórios sem entrada marcada são
+// ignorados
+void latency_report_complete(uint instance) {
+  if (instance >= LATENCY_INSTANCES || !latency_in_flight[instance].valid) return;
+  latency_in_flight[instance].valid = false;
+
+  uint32_t now = time_us_32();
+  uint32_t input_us = latency_in_flight[instance].input_us;
+  uint32_t report_us = latency_in_flight[instance].report_us;
+  latency_histogram_t *histograms = latency_histograms[latency_in_flight[instance].mode];
+  latency_record(&histograms[LATENCY_INPUT_TO_REPORT], report_us - input_us);
+  latency_record(&histograms[LATENCY_REPORT_TO_HOST], now - report_us);
+  latency_record(&histograms[LATENCY_INPUT_TO_HOST], now - input_us);
+}
+
+const latency_histogram_t *latency_histogram(uint mode, latency_stage_t stage) {
+  return &latency_histograms[mode][stage];
+}
+
+// Limite superior da faixa onde está o percentil pedido, em microssegundos
+uint32_t latency_percentile(const latency_histogram_t *histogram, uint percent) {
+  if (!histogram->count) return 0;
+
+  uint32_t target = (histogram->count * percent + 99) / 100;
+  uint32_t seen = 0;
+  for (uint i = 0; i < LATENCY_BUCKETS - 1; ++i) {
+    seen += histogram->buckets[i];
+    if (seen >= target) {
+      uint32_t limit = 1u << (LATENCY_FIRST_BUCKET_BITS + i);
+      return limit < histogram->max_us ? limit : histogram->max_us;
+    }
+  }
+  return histogram->max_us;
+}
+
+// Escreve os histogramas de uma função na saída padrão (UART de depuração)
+void latency_print(uint mode, const char *name) {
+  for (uint stage = 0; stage < LATENCY_STAGES; ++stage) {
+    const latency_histogram_t *histogram = &latency_histograms[mode][stage];
+    uint32_t average = histogram->count ? histogram->sum_us / histogram->count : 0;
+    printf("%s %s: n=%lu media=%luus p50<=%luus p99<=%luus max=%luus\n",
+      name, latency_stage_names[stage], (unsigned long)histogram->count,
+      (unsigned long)average,
+      (unsigned long)latency_percentile(histogram, 50),
+      (unsigned long)latency_percentile(histogram, 99),
+      (unsigned long)histogram->max_us);
+
+    for (uint i = 0; i < LATENCY_BUCKETS; ++i) {
+      if (!histogram->buckets[i]) continue;
+      if (i < LATENCY_BUCKETS - 1) {
+        printf("  <%6luus %lu\n", 1ul << (LATENCY_FIRST_BUCKET_BITS + i),
+          (unsigned long)histogram->buckets[i]);
+      } else {
+        printf("  >=%5luus %lu\n", 1ul << (LATENCY_FIRST_BUCKET_BITS + i - 1),
+          (unsigned long)histogram->buckets[i]);
+      }
+    }
+  }
+}
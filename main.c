@@ -3,29 +3,66 @@
 #include <string.h>
 #include "bsp/board_api.h"
 #include "tusb.h"
+#include "pico/multicore.h"
 #include "usb_descriptors.h"
 
 #include "hardware/adc.h"
 
 #include "joystick/joystick.h"
+#include "joystick/calibration.h"
+#include "joystick/filter.h"
+#include "mouse/acceleration.h"
+#include "latency/latency.h"
 #include "buttons/buttons.h"
+#include "buttons/debounce.h"
+#include "buttons/events.h"
+#include "hid/report_queue.h"
+#include "power/power.h"
+#include "ui/channel.h"
 #include "display/ssd1306.c"
+#include "display/console.c"
 
-// Intervalo de envio
-#define HID_INTERVAL_MS 100
+// Menor intervalo entre dois relatórios do mesmo tipo. O mouse acompanha a
+// taxa de consulta do computador; o teclado segura cada tecla por pelo
+// menos esse tempo
+#define MOUSE_MIN_INTERVAL_US 1000
+#define KEYBOARD_MIN_INTERVAL_US 10000
+#define GAMEPAD_MIN_INTERVAL_US 1000
 
-// Definições para ADC
-#define ADC_MAX 4095
-// Valor central do ADC
-#define ADC_CENTER (ADC_MAX / 2)
+// Intervalo de leitura do botão BOOTSEL
+#define BOARD_BUTTON_INTERVAL_MS 10
+
+// Posição do eixo, já calibrada, a partir da qual o teclado e o controle
+// consideram o joystick inclinado
+#define JOYSTICK_THRESHOLD (JOYSTICK_SCALE / 2)
 
 // Configuração de escala para movimento do cursor
-// Velocidade máxima do mouse
+// Velocidade máxima do mouse, em pontos a cada 10 ms
 #define MOUSE_MAX_SPEED 10
+// Formato da curva de aceleração: 0 é linear, 256 é cúbica
+#define MOUSE_ACCEL_SHAPE 192
+
+// Taxa máxima de atualização do display, em quadros por segundo
+#define UI_MAX_FPS 20
+// Intervalo de atualização da tela de latências
+#define UI_LATENCY_REFRESH_MS 500
+// Intervalo de consulta de um envio ao display em andamento, que não
+// avisa por interrupção quando termina
+#define UI_DISPLAY_POLL_US 1000
+// Espera para publicar de novo o estado da interface com o canal cheio
+#define UI_CHANNEL_RETRY_US 1000
 
 // Protótipos das funções
 void led_blinking_task(void);
 void hid_task(void);
+void hid_report_task(void);
+void ui_task(void);
+void ui_core1_main(void);
+uint32_t ui_core1_task(void);
+void ui_display_power(bool on);
+void input_task(void);
+void suspend_task(void);
+void joystick_calibration_task(void);
 
 // Configuração do intervalo de piscar do LED
 enum {
@@ -37,266 +74,847 @@ enum {
 static uint32_t blink_interval_ms = BLINK_NOT_MOUNTED;
 
 // Quantidade de funções que o dispositivo tem
-#define TOTAL_FUNCTIONS 3
+#define TOTAL_FUNCTIONS 4
 // 0: Mouse
 // 1: Teclado
-// 3: Controle
+// 2: Controle
+// 3: Gamepad
 uint hid_function = 0;
-uint last_hid_function = 0;
 
-// Armazena o tempo do último evento (em microssegundos)
-static volatile uint32_t last_time = 0;
+// Nomes exibidos para cada função
+static const char *hid_function_names[TOTAL_FUNCTIONS] = {
+  "MOUSE", "TECLADO", "CONTROLE", "GAMEPAD"
+};
 
-uint8_t mouse_actions = 0;
+// Atraso máximo que o filtro de tremor pode somar, em us: um período de
+// relatório do laço de 10 ms anterior ao envio por conclusão. Preso ao
+// período de 1 ms do mouse, o filtro não teria como suavizar um tremor de
+// poucos hertz
+#define JOYSTICK_FILTER_MAX_LAG_US 10000
+
+// Filtro de tremor de cada função: com o joystick quase parado, corta o
+// tremor pela metade; em movimento, abre o corte para ficar dentro de
+// JOYSTICK_FILTER_MAX_LAG_US. Mouse e gamepad abrem o corte um pouco mais
+// cedo; teclado e controle só comparam a posição com um limiar e podem
+// suavizar mais. O teste host/filter_test.c confere os perfis com os
+// traços de host/traces
+static const joystick_filter_profile_t joystick_filter_profiles[TOTAL_FUNCTIONS] = {
+  { .min_cutoff = 250, .beta = 9000, .derivative_cutoff = 1000 },
+  { .min_cutoff = 250, .beta = 8000, .derivative_cutoff = 1000 },
+  { .min_cutoff = 250, .beta = 8000, .derivative_cutoff = 1000 },
+  { .min_cutoff = 250, .beta = 9000, .derivative_cutoff = 1000 },
+};
+
+// Indica que o estado exibido no display mudou e precisa ser publicado
+// para o núcleo 1
+static volatile bool ui_changed = true;
+// Estado da interface, do núcleo 0 para o núcleo 1, que cuida do display
+static ui_channel_t ui_channel;
+// Painel ligado; desligado durante a suspensão do USB
+static bool ui_display_on = true;
+// Registro das trocas de função e dos caracteres escolhidos no display,
+// do núcleo 1. Cada linha nova rola a tela e envia uma só página
+static ssd1306_console_t ui_console;
+
+// Eventos dos botões, das interrupções para o laço principal
+static event_queue_t input_events;
+
+// Relatórios pendentes de cada tipo
+static hid_report_queue_t keyboard_queue;
+static hid_report_queue_t mouse_queue;
+static hid_report_queue_t gamepad_queue;
+
+// Botão de troca de função seguro: ao soltar, não troca a função
+static bool function_button_held = false;
+// Mostra os histogramas de latência da função atual no lugar do nome
+static bool ui_latency = false;
+
+// Botões do mouse pressionados agora
+static uint8_t mouse_buttons = 0;
+// Movimento fracionário acumulado em cada eixo do mouse
+static mouse_axis_t mouse_axis_x, mouse_axis_y;
+// Instante em que o movimento do mouse foi calculado pela última vez. O
+// primeiro cálculo depois de entrar na função mouse ou de sair da
+// suspensão conta a partir daí, e não do último relatório
+static uint32_t mouse_motion_us = 0;
+// Botões do gamepad pressionados agora
+static uint8_t gamepad_buttons = 0;
 
 uint keyboard_character = HID_KEY_A - 1;
-uint8_t keycode[6] = {0};
-uint8_t keycode_count = 0;
+// Teclas mantidas pressionadas pelo joystick
+static uint8_t keyboard_held[6] = {0};
+
 
 
+// Avisa a tarefa do display que o estado mudou. Vários avisos antes da
+// próxima publicação resultam em uma única mensagem
+static inline void ui_notify(void) {
+  ui_changed = true;
+}
 
 // Função de conversão do caractere HID para correspondente ASCII
 char convertHIDKeyToASCII(uint HID_key) {
   if(HID_key >= HID_KEY_A && HID_key <= HID_KEY_Z)
     return HID_key + 'A' - HID_KEY_A;
+  return '?';
 }
 
 
 
-void gpio_irq_handler(uint gpio, uint32_t events) {
-  // Obtém o tempo atual em microssegundos
-  uint32_t current_time = to_us_since_boot(get_absolute_time());
+// Botão do mouse correspondente a cada botão da placa
+static uint8_t mouse_button_of(uint button) {
+  if (button == BUTTON_A) return MOUSE_BUTTON_RIGHT;
+  if (button == BUTTON_B) return MOUSE_BUTTON_LEFT;
+  return 0;
+}
+
+// Acrescenta uma tecla a um relatório do teclado. Retorna false se não
+// couber ou se a tecla já estiver no relatório
+static bool keys_add(uint8_t keys[6], uint8_t *count, uint8_t key) {
+  if (*count == 6) return false;
+  for (uint i = 0; i < *count; ++i) {
+    if (keys[i] == key) return false;
+  }
+  keys[(*count)++] = key;
+  return true;
+}
 
-  // Verifica se passou tempo suficiente desde o último evento
-  // 200 ms de debouncing
-  if (current_time - last_time > 500000) {
-    // Atualiza o tempo do último evento
-    last_time = current_time;
+// Enfileira um toque de tecla: um relatório com a tecla pressionada junto
+// das mantidas pelo joystick e outro só com as mantidas. Retorna false se a
+// fila não tiver espaço para o par, e o toque deve esperar
+static bool keyboard_tap(uint8_t key, uint32_t time_us) {
+  if (hid_queue_space(&keyboard_queue) < 2) return false;
+
+  uint8_t pressed[6];
+  uint8_t count = 0;
+  memcpy(pressed, keyboard_held, sizeof(pressed));
+  while (count < 6 && pressed[count]) count++;
+  keys_add(pressed, &count, key);
+
+  hid_queue_push(&keyboard_queue, pressed, true, time_us);
+  hid_queue_push(&keyboard_queue, keyboard_held, false, 0);
+  return true;
+}
+
+// Atualiza as teclas mantidas pelo joystick, enfileirando um relatório se
+// elas mudaram
+static void keyboard_hold(const uint8_t keys[6], uint32_t time_us) {
+  if (memcmp(keys, keyboard_held, sizeof(keyboard_held)) == 0) return;
+  memcpy(keyboard_held, keys, sizeof(keyboard_held));
+  hid_queue_push(&keyboard_queue, keyboard_held, true, time_us);
+}
+
+// Enfileira o novo estado dos botões do mouse, sem movimento
+static void mouse_buttons_push(uint32_t time_us) {
+  uint8_t report[5] = { mouse_buttons };
+  hid_queue_push(&mouse_queue, report, true, time_us);
+}
+
+// Botão do gamepad correspondente a cada botão da placa
+static uint8_t gamepad_button_of(uint button) {
+  if (button == BUTTON_A) return GAMEPAD_BUTTON_A;
+  if (button == BUTTON_B) return GAMEPAD_BUTTON_B;
+  return 0;
+}
+
+// Enfileira o novo estado dos botões do gamepad; os eixos são lidos na hora
+// do envio
+static void gamepad_buttons_push(uint32_t time_us) {
+  hid_queue_push(&gamepad_queue, &gamepad_buttons, true, time_us);
+}
 
-    if (gpio == JOYSTICK_BUTTON) {
+// Recebe os eventos dos botões já sem ressalto, nas interrupções, e os
+// repassa ao laço principal
+void button_event_handler(uint button, button_event_t event, uint32_t time_us) {
+  event_queue_push(&input_events, button, event, time_us);
+}
+
+// Limites de taxa e contadores de um tipo de relatório. Só são enviados
+// relatórios que mudam algo no computador; cada intervalo de consulta em
+// que o endpoint estava livre e nada mudou conta como um relatório suprimido
+typedef struct {
+  // Menor intervalo entre dois relatórios
+  uint32_t min_interval_us;
+  // Instante do último relatório enviado
+  uint32_t last_us;
+  // Início do intervalo de consulta atual sem envio
+  uint32_t idle_us;
+  uint32_t sent;
+  uint32_t suppressed;
+} hid_rate_t;
+
+static hid_rate_t mouse_rate = { .min_interval_us = MOUSE_MIN_INTERVAL_US };
+static hid_rate_t keyboard_rate = { .min_interval_us = KEYBOARD_MIN_INTERVAL_US };
+static hid_rate_t gamepad_rate = { .min_interval_us = GAMEPAD_MIN_INTERVAL_US };
+
+// Verifica se o limite de taxa permite enviar um relatório agora
+static bool hid_rate_allows(const hid_rate_t *rate, uint32_t now) {
+  return now - rate->last_us >= rate->min_interval_us;
+}
+
+static void hid_rate_sent(hid_rate_t *rate, uint32_t now) {
+  rate->last_us = now;
+  rate->idle_us = now;
+  rate->sent++;
+}
+
+// Conta um intervalo de consulta sem nada para enviar
+static void hid_rate_idle(hid_rate_t *rate, uint32_t now) {
+  if (now - rate->idle_us < HID_POLL_INTERVAL_MS * 1000) return;
+  rate->idle_us = now;
+  rate->suppressed++;
+}
+
+// Se o limite de taxa está segurando um relatório, acorda o laço quando
+// ele voltar a permitir. Com o limite livre, quem acorda o laço é a
+// próxima leitura do joystick ou a interrupção de um botão ou do USB
+static void hid_rate_deadline(const hid_rate_t *rate) {
+  uint32_t elapsed_us = time_us_32() - rate->last_us;
+  if (elapsed_us < rate->min_interval_us) {
+    power_deadline_after(elapsed_us, rate->min_interval_us);
+  }
+}
+
+// Escreve os histogramas de latência de todas as funções na saída padrão
+static void latency_print_all(void) {
+  for (uint function = 0; function < TOTAL_FUNCTIONS; ++function) {
+    latency_print(function, hid_function_names[function]);
+  }
+  printf("eventos descartados: %lu\n", (unsigned long)input_events.overflows);
+  printf("relatorios substituidos: teclado %lu mouse %lu gamepad %lu\n",
+    (unsigned long)keyboard_queue.overflows, (unsigned long)mouse_queue.overflows,
+    (unsigned long)gamepad_queue.overflows);
+  printf("relatorios enviados/suprimidos: teclado %lu/%lu mouse %lu/%lu gamepad %lu/%lu\n",
+    (unsigned long)keyboard_rate.sent, (unsigned long)keyboard_rate.suppressed,
+    (unsigned long)mouse_rate.sent, (unsigned long)mouse_rate.suppressed,
+    (unsigned long)gamepad_rate.sent, (unsigned long)gamepad_rate.suppressed);
+  uint32_t idle = power_idle_permille();
+  printf("ocioso %lu.%lu%%, %lu despertares/s\n", (unsigned long)(idle / 10),
+    (unsigned long)(idle % 10), (unsigned long)power_wakeups_per_second());
+  printf("remote wakeup: retomada %lu us, primeiro relatorio %lu us\n",
+    (unsigned long)power.wakeup_to_resume_us, (unsigned long)power.wakeup_to_report_us);
+}
+
+// Aplica um evento de botão ao estado dos relatórios HID. Retorna false se
+// o evento ainda não cabe no próximo relatório
+static bool input_event_apply(const input_event_t *input) {
+  uint button = input->button;
+  uint event = input->event;
+
+  if (button == JOYSTICK_BUTTON || button == BUTTON_BOARD) {
+    // Segurar o botão mostra ou esconde as latências; um clique curto
+    // troca de função ao soltar
+    if (event == BUTTON_EVENT_HOLD) {
+      function_button_held = true;
+      ui_latency = !ui_latency;
+      ui_notify();
+    } else if (event == BUTTON_EVENT_RELEASE && function_button_held) {
+      function_button_held = false;
+    } else if (event == BUTTON_EVENT_RELEASE) {
       hid_function = hid_function + 1 == TOTAL_FUNCTIONS ? 0 : hid_function + 1;
+      // Botões seguros no mouse e teclas mantidas pelo joystick são
+      // soltos antes de trocar de função
+      static const uint8_t no_keys[6] = {0};
+      keyboard_hold(no_keys, input->time_us);
+      mouse_buttons = 0;
+      mouse_buttons_push(input->time_us);
+      gamepad_buttons = 0;
+      gamepad_buttons_push(input->time_us);
+      mouse_motion_us = time_us_32();
+      ui_notify();
     }
+    return true;
+  }
 
-    if(hid_function == 0) {
+  if(hid_function == 0) {
 
-      if(gpio == BUTTON_A) {
-        mouse_actions |= MOUSE_BUTTON_RIGHT; 
-      } else if (gpio == BUTTON_B) {
-        mouse_actions |= MOUSE_BUTTON_LEFT;
-      }
+    // Os botões do mouse acompanham os botões da placa, permitindo arrastar
+    if (event != BUTTON_EVENT_PRESS && event != BUTTON_EVENT_RELEASE) return true;
+    if (!hid_queue_space(&mouse_queue)) return false;
+    if (event == BUTTON_EVENT_PRESS) {
+      mouse_buttons |= mouse_button_of(button);
+    } else {
+      mouse_buttons &= ~mouse_button_of(button);
+    }
+    mouse_buttons_push(input->time_us);
+
+  } else if(hid_function == 1) {
 
-    } else if(hid_function == 1) {
-
-      if(gpio == BUTTON_A) {
-        if(keyboard_character > HID_KEY_A); {
-          keyboard_character--;
-          keycode[0] = keyboard_character;
-        }
-      } else if (gpio == BUTTON_B) {
-        if(keyboard_character < HID_KEY_Z) {
-          keyboard_character++;
-          keycode[0] = keyboard_character;
-        }
+    if (event != BUTTON_EVENT_PRESS) return true;
+    if (hid_queue_space(&keyboard_queue) < 2) return false;
+    if(button == BUTTON_A) {
+      if(keyboard_character > HID_KEY_A) {
+        keyboard_character--;
+        keyboard_tap(keyboard_character, input->time_us);
       }
-      char character_message[50];
-      sprintf(character_message, "CARACTERE %c", convertHIDKeyToASCII(keyboard_character));
-      display_draw_string(character_message, 8, 22);
-      display_send_data();
+    } else if (button == BUTTON_B) {
+      if(keyboard_character < HID_KEY_Z) {
+        keyboard_character++;
+        keyboard_tap(keyboard_character, input->time_us);
+      }
+    }
+    ui_notify();
 
-    } else if(hid_function == 2) {
+  } else if(hid_function == 2) {
 
-      if(gpio == BUTTON_A) {
-        keycode[keycode_count++] = HID_KEY_ENTER;
-      } else if (gpio == BUTTON_B) {
-        keycode[keycode_count++] = HID_KEY_SPACE;
-      }
+    if (event != BUTTON_EVENT_PRESS) return true;
+    uint8_t key = button == BUTTON_A ? HID_KEY_ENTER : HID_KEY_SPACE;
+    return keyboard_tap(key, input->time_us);
+
+  } else if(hid_function == 3) {
+
+    // Os botões do gamepad acompanham os botões da placa
+    if (event != BUTTON_EVENT_PRESS && event != BUTTON_EVENT_RELEASE) return true;
+    if (!hid_queue_space(&gamepad_queue)) return false;
+    if (event == BUTTON_EVENT_PRESS) {
+      gamepad_buttons |= gamepad_button_of(button);
+    } else {
+      gamepad_buttons &= ~gamepad_button_of(button);
     }
+    gamepad_buttons_push(input->time_us);
+  }
+  return true;
+}
+
+// Consome os eventos dos botões na ordem em que aconteceram. Um evento que
+// ainda não cabe no relatório fica na fila, segurando os seguintes
+void input_task(void) {
+  input_event_t input;
+  while (event_queue_peek(&input_events, &input)) {
+    if (!input_event_apply(&input)) break;
+    event_queue_pop(&input_events);
+  }
+}
+
+// Com o USB suspenso, um evento de botão pede ao computador para acordar.
+// Os eventos ficam na fila e viram relatórios depois da retomada; se o
+// computador não permitiu o remote wakeup, são descartados
+void suspend_task(void) {
+  input_event_t input;
+  if (!event_queue_peek(&input_events, &input)) return;
+  if (power_request_wakeup()) return;
+  while (event_queue_peek(&input_events, &input)) {
+    event_queue_pop(&input_events);
   }
 }
 
 
 
 
-int main(void) {
+// Inicializa a placa, o joystick, o display (no núcleo 1), o USB e os
+// botões
+void device_init(void) {
   board_init();
 
   // Inicializa os periféricos
   setup_joystick();
   setup_buttons();
   setup_display_oled();
+  joystick_calibration_task();
+  ssd1306_console_init(&ui_console, &ssd);
+  // A partir daqui o display é só do núcleo 1
+  multicore_launch_core1(ui_core1_main);
+  mouse_acceleration_init(MOUSE_MAX_SPEED, MOUSE_ACCEL_SHAPE);
 
-  // Inicializa a pilha USB
+  // Inicializa a pilha USB e as filas de relatórios
   tud_init(BOARD_TUD_RHPORT);
+  hid_queue_init(&keyboard_queue, HID_ITF_KEYBOARD, REPORT_ID_KEYBOARD, 6);
+  hid_queue_init(&mouse_queue, HID_ITF_MOUSE, REPORT_ID_MOUSE, 5);
+  hid_queue_init(&gamepad_queue, HID_ITF_GAMEPAD, REPORT_ID_GAMEPAD, 1);
+
+  // Configura as interrupções dos botões, com debounce por pino
+  button_set_event_callback(&button_event_handler);
+  button_watch(BUTTON_A);
+  button_watch(BUTTON_B);
+  button_watch(JOYSTICK_BUTTON);
+  button_watch_polled(BUTTON_BOARD);
+
+  power_stats_reset();
+}
 
-  // Configura as interrupções
-  gpio_set_irq_enabled_with_callback(BUTTON_A, GPIO_IRQ_LEVEL_LOW, true, &gpio_irq_handler);
-  gpio_set_irq_enabled_with_callback(BUTTON_B, GPIO_IRQ_LEVEL_LOW, true, &gpio_irq_handler);
-  gpio_set_irq_enabled_with_callback(
-    JOYSTICK_BUTTON, GPIO_IRQ_EDGE_FALL, true, &gpio_irq_handler
-  );
-
-  print_hid_function("MOUSE");
-
-  while (1) {
-    // Tarefa do TinyUSB
-    tud_task(); 
-    led_blinking_task();
+// Uma volta do laço principal do núcleo 0. Cada tarefa informa quando
+// volta a ter trabalho; entre uma volta e outra o núcleo dorme até o prazo
+// mais próximo ou uma interrupção (power_sleep)
+void device_task(void) {
+  power_deadline_reset();
+  // Tarefa do TinyUSB
+  tud_task(); 
+  if (power.suspended) {
+    // Só os botões, por interrupção, acordam o computador
+    suspend_task();
+  } else {
+    // Aplica os eventos dos botões
+    input_task();
+    // Filtra a posição do joystick a taxa fixa
+    joystick_filter_task(&joystick_filter_profiles[hid_function]);
+    power_deadline_at(joystick_filter.next_us);
+    // Publica mudanças da interface para o núcleo 1
+    ui_task();
     // Envia os relatórios HID
     hid_task(); 
   }
+  led_blinking_task();
 }
 
+// Na compilação para o host (host/device_sim.c), o simulador conduz
+// device_init e device_task sobre o relógio virtual
+#ifndef HOST_BUILD
+int main(void) {
+  device_init();
+  while (1) {
+    device_task();
+    power_sleep();
+  }
+}
+#endif
+
+
+// Volta da suspensão: restaura o clock, o ADC e o display. Também é
+// chamada na montagem e desmontagem, porque um reset do barramento tira o
+// dispositivo da suspensão sem passar por tud_resume_cb
+static void usb_resume(void) {
+  if (!power.suspended) return;
+  power_resume();
+  mouse_motion_us = time_us_32();
+  joystick_sampling_start();
+  ui_display_power(true);
+}
 
 // Callbacks de status USB
-void tud_mount_cb(void) { blink_interval_ms = BLINK_MOUNTED; }
-void tud_umount_cb(void) { blink_interval_ms = BLINK_NOT_MOUNTED; }
+void tud_mount_cb(void) {
+  usb_resume();
+  blink_interval_ms = BLINK_MOUNTED;
+}
+void tud_umount_cb(void) {
+  usb_resume();
+  blink_interval_ms = BLINK_NOT_MOUNTED;
+}
 void tud_suspend_cb(bool remote_wakeup_en) {
-  (void)remote_wakeup_en;
   blink_interval_ms = BLINK_SUSPENDED;
+  // Para o que depende do clock do sistema antes de reduzi-lo
+  ui_display_power(false);
+  joystick_sampling_stop();
+  power_suspend(remote_wakeup_en);
 }
 void tud_resume_cb(void) { 
+  usb_resume();
   blink_interval_ms = tud_mounted() ? BLINK_MOUNTED : BLINK_NOT_MOUNTED; 
 }
 
 
 
-// Função para mapear valores do ADC para deslocamento do cursor
-int8_t adc_to_mouse_movement(uint16_t adc_value) {
-  int16_t mapped = ((int16_t)adc_value - ADC_CENTER) * MOUSE_MAX_SPEED / ADC_CENTER;
-  return (int8_t)mapped;
+// Mostra uma mensagem de calibração, esperando o envio ao display
+static void calibration_message(const char *line1, const char *line2) {
+  display_fill(false);
+  display_draw_string(line1, 8, 8);
+  display_draw_string(line2, 8, 22);
+  ssd1306_send_data(&ssd);
 }
 
-// Envia um relatório HID de movimento do mouse baseado no ADC
-void hid_mouse_task() {
+// Calibra o joystick na inicialização, antes do USB. Com o botão do
+// joystick pressionado, mede o repouso e os extremos e grava o resultado;
+// sem ele, usa a calibração gravada ou, se não houver, mede só o repouso
+void joystick_calibration_task(void) {
+  bool full = !gpio_get(JOYSTICK_BUTTON);
 
-  if (!tud_hid_ready()) return;
+  if (!full && joystick_calibration_load()) return;
 
-  // Lê o ADC
-  uint16_t adc_value_y = read_Y();
-  uint16_t adc_value_x = read_X();
+  calibration_message("CALIBRANDO", "NAO MOVA");
+  joystick_calibrate_rest();
+  if (full) {
+    calibration_message("CALIBRANDO", "GIRE AS BORDAS");
+    joystick_calibrate_range();
+  }
+  joystick_calibration_save();
 
-  // Converte ADC para movimento do cursor
-  int8_t delta_x = adc_to_mouse_movement(adc_value_x);
-  int8_t delta_y = adc_to_mouse_movement(adc_value_y);
+  // Espera soltar o botão para não trocar de função ao iniciar
+  while (!gpio_get(JOYSTICK_BUTTON)) {
+    sleep_ms(10);
+  }
+}
 
-  // Envia o relatório do mouse
-  tud_hid_mouse_report(REPORT_ID_MOUSE, mouse_actions, delta_x, -delta_y, 0, 0);
-  mouse_actions = 0;
+// Registra um relatório enviado na interface para a medição de latência:
+// a entrada é a guardada na fila ou, se não houver, a leitura do joystick
+// quando ele moveu o relatório
+static void hid_report_sent(uint instance, const hid_pending_report_t *pending, bool joystick_active) {
+  if (pending && pending->has_input) {
+    latency_report_sent(instance, hid_function, pending->input_us);
+  } else if (joystick_active) {
+    latency_report_sent(instance, hid_function, joystick_filtered_time());
+  }
 }
 
+// Envia um relatório do mouse: o próximo estado dos botões na fila, com o
+// movimento do joystick somado quando motion é verdadeiro. Sem botões
+// pendentes e sem movimento, nada é enviado
+static void hid_mouse_task(bool motion) {
+  uint32_t now = time_us_32();
+  if (!hid_rate_allows(&mouse_rate, now)) return;
+
+  hid_pending_report_t *pending = hid_queue_peek(&mouse_queue);
+  uint8_t buttons = pending ? pending->data[0] : hid_queue_state(&mouse_queue)[0];
+
+  // Converte a posição calibrada e filtrada do joystick para movimento do
+  // cursor, proporcional ao tempo desde o último cálculo
+  int8_t delta_x = 0, delta_y = 0;
+  mouse_axis_t axis_x = mouse_axis_x, axis_y = mouse_axis_y;
+  if (motion) {
+    uint32_t elapsed_us = now - mouse_motion_us;
+    delta_x = mouse_acceleration_apply(&axis_x, joystick_filtered_x(), elapsed_us);
+    delta_y = mouse_acceleration_apply(&axis_y, joystick_filtered_y(), elapsed_us);
+  }
 
-void hid_keyboard_task(void) {
+  // Movimento menor que um ponto fica nos acumuladores para o próximo
+  if (!pending && !delta_x && !delta_y) {
+    mouse_motion_us = now;
+    mouse_axis_x = axis_x;
+    mouse_axis_y = axis_y;
+    hid_rate_idle(&mouse_rate, now);
+    return;
+  }
 
-  static uint32_t start_ms = 0;
-  if (board_millis() - start_ms < HID_INTERVAL_MS) return;
-  start_ms = board_millis();
+  // Envia o relatório do mouse. O movimento só é descontado dos
+  // acumuladores se o relatório foi aceito
+  if (!tud_hid_n_mouse_report(
+    mouse_queue.instance, mouse_queue.report_id, buttons, delta_x, -delta_y, 0, 0
+  )) return;
+  hid_rate_sent(&mouse_rate, now);
+  mouse_motion_us = now;
+  mouse_axis_x = axis_x;
+  mouse_axis_y = axis_y;
+  hid_report_sent(mouse_queue.instance, pending, delta_x || delta_y);
+  if (pending) hid_queue_pop(&mouse_queue);
+}
 
-  // Verifica se o HID está pronto
-  if (!tud_hid_ready()) return;
+// Converte a posição de um eixo para o eixo do gamepad, de
+// -GAMEPAD_AXIS_MAX a GAMEPAD_AXIS_MAX
+static int16_t gamepad_axis(int16_t position) {
+  return (int32_t)position * GAMEPAD_AXIS_MAX / JOYSTICK_SCALE;
+}
 
-  // Lê o ADC
-  uint16_t adc_value_y = read_Y();
-  if(adc_value_y > ADC_CENTER + ADC_CENTER / 2) {
-    uint8_t keycode[6] = {0};
-    keycode[0] = HID_KEY_BACKSPACE;
-    tud_hid_keyboard_report(REPORT_ID_KEYBOARD, 0, keycode);
+// Eixos do último relatório do gamepad enviado
+static int16_t gamepad_sent_x = 0, gamepad_sent_y = 0;
+
+// Envia um relatório do gamepad: o próximo estado dos botões na fila, com
+// os eixos do joystick quando axes é verdadeiro ou centralizados. Sem
+// botões pendentes e com os eixos parados, nada é enviado
+static void hid_gamepad_task(bool axes) {
+  uint32_t now = time_us_32();
+  if (!hid_rate_allows(&gamepad_rate, now)) return;
+
+  hid_pending_report_t *pending = hid_queue_peek(&gamepad_queue);
+  uint8_t buttons = pending ? pending->data[0] : hid_queue_state(&gamepad_queue)[0];
+
+  // O eixo Y do gamepad cresce para baixo, ao contrário do joystick
+  int16_t x = axes ? gamepad_axis(joystick_filtered_x()) : 0;
+  int16_t y = axes ? gamepad_axis(-joystick_filtered_y()) : 0;
+  bool moved = x != gamepad_sent_x || y != gamepad_sent_y;
+  if (!pending && !moved) {
+    hid_rate_idle(&gamepad_rate, now);
+    return;
   }
 
-  tud_hid_keyboard_report(REPORT_ID_KEYBOARD, 0, keycode);
-  for(int i = 0; i < 6; i++) {
-    keycode[i] = 0;
-  }
-  keycode_count = 0;
+  gamepad_report_t report = { .x = x, .y = y, .buttons = buttons };
+  if (!tud_hid_n_report(
+    gamepad_queue.instance, gamepad_queue.report_id, &report, sizeof(report)
+  )) return;
+  hid_rate_sent(&gamepad_rate, now);
+  gamepad_sent_x = x;
+  gamepad_sent_y = y;
+  hid_report_sent(gamepad_queue.instance, pending, moved && axes);
+  if (pending) hid_queue_pop(&gamepad_queue);
 }
 
-void hid_control_task(void) {
+// Envia o próximo relatório pendente do teclado
+static void keyboard_report_send(void) {
+  uint32_t now = time_us_32();
+  hid_pending_report_t *pending = hid_queue_peek(&keyboard_queue);
+  if (!pending || !hid_rate_allows(&keyboard_rate, now)) return;
+
+  if (!tud_hid_n_keyboard_report(
+    keyboard_queue.instance, keyboard_queue.report_id, 0, pending->data
+  )) return;
+  hid_rate_sent(&keyboard_rate, now);
+  hid_report_sent(keyboard_queue.instance, pending, false);
+  hid_queue_pop(&keyboard_queue);
+}
 
-  static uint32_t start_ms = 0;
-  if (board_millis() - start_ms < HID_INTERVAL_MS) return;
-  start_ms = board_millis();
+// Teclas mantidas pelo joystick na função teclado: apagar
+void hid_keyboard_task(void) {
+  uint8_t keys[6] = {0};
+  uint8_t count = 0;
 
-  // Verifica se o HID está pronto
-  if (!tud_hid_ready()) return;
+  if(joystick_filtered_y() > JOYSTICK_THRESHOLD) {
+    keys_add(keys, &count, HID_KEY_BACKSPACE);
+  }
 
-  // Lê o ADC
-  uint16_t adc_value_y = read_Y();
-  uint16_t adc_value_x = read_X();
+  keyboard_hold(keys, joystick_filtered_time());
+}
 
-  if(adc_value_y > ADC_CENTER + ADC_CENTER / 2) {
-    uint8_t keycode[6] = {0};
-    keycode[0] = HID_KEY_ARROW_UP;
-    tud_hid_keyboard_report(REPORT_ID_KEYBOARD, 0, keycode);
+// Teclas mantidas pelo joystick na função controle: as setas
+void hid_control_task(void) {
+  uint8_t keys[6] = {0};
+  uint8_t count = 0;
+
+  // Lê a posição calibrada e filtrada do joystick
+  int16_t position_y = joystick_filtered_y();
+  int16_t position_x = joystick_filtered_x();
+
+  if(position_y > JOYSTICK_THRESHOLD) {
+    keys_add(keys, &count, HID_KEY_ARROW_UP);
   }
-  if(adc_value_y < ADC_CENTER - ADC_CENTER / 2) {
-    uint8_t keycode[6] = {0};
-    keycode[0] = HID_KEY_ARROW_DOWN;
-    tud_hid_keyboard_report(REPORT_ID_KEYBOARD, 0, keycode);
+  if(position_y < -JOYSTICK_THRESHOLD) {
+    keys_add(keys, &count, HID_KEY_ARROW_DOWN);
   }
-  if(adc_value_x > ADC_CENTER + ADC_CENTER / 2) {
-    uint8_t keycode[6] = {0};
-    keycode[0] = HID_KEY_ARROW_RIGHT;
-    tud_hid_keyboard_report(REPORT_ID_KEYBOARD, 0, keycode);
+  if(position_x > JOYSTICK_THRESHOLD) {
+    keys_add(keys, &count, HID_KEY_ARROW_RIGHT);
   }
-  if(adc_value_x < ADC_CENTER - ADC_CENTER / 2) {
-    uint8_t keycode[6] = {0};
-    keycode[0] = HID_KEY_ARROW_LEFT;
-    tud_hid_keyboard_report(REPORT_ID_KEYBOARD, 0, keycode);
+  if(position_x < -JOYSTICK_THRESHOLD) {
+    keys_add(keys, &count, HID_KEY_ARROW_LEFT);
   }
 
-  tud_hid_keyboard_report(REPORT_ID_KEYBOARD, 0, keycode);
-  for(int i = 0; i < 6; i++) {
-    keycode[i] = 0;
-  }
-  keycode_count = 0;
+  keyboard_hold(keys, joystick_filtered_time());
 }
 
-
-// Tarefa para envio periódico dos relatórios HID
-void hid_task(void) {
-  const uint32_t interval_ms = 10;
-  static uint32_t start_ms = 0;
-
-  if (board_millis() - start_ms < interval_ms) return;
-  start_ms += interval_ms;
-
-  uint32_t const btn = board_button_read();
-  if(btn) {
-    // Obtém o tempo atual em microssegundos
-    uint32_t current_time = to_us_since_boot(get_absolute_time());
-    // Verifica se passou tempo suficiente desde o último evento
-    // 200 ms de debouncing
-    if (current_time - last_time > 200000) {
-      // Atualiza o tempo do último evento
-      last_time = current_time;
-      hid_function = hid_function + 1 == TOTAL_FUNCTIONS ? 0 : hid_function + 1;
-    }
-  }
-
+// Envia o próximo relatório de cada interface cujo endpoint estiver livre,
+// se houver mudança e o limite de taxa do tipo permitir. Teclado, mouse e
+// gamepad têm endpoints próprios e podem sair no mesmo quadro USB. É
+// chamada a cada volta do laço e também quando o computador recebe um
+// relatório, para que o seguinte saia logo que o endpoint fica livre
+void hid_report_task(void) {
   switch (hid_function) {
-    case 0:
-      if(last_hid_function != hid_function) {
-        print_hid_function("MOUSE");
-        last_hid_function = hid_function;
-      }
-      hid_mouse_task();
-      break;
     case 1:
-      if(last_hid_function != hid_function) {
-        print_hid_function("TECLADO");
-        last_hid_function = hid_function;
-      }
       hid_keyboard_task();
       break;      
     case 2:
-      if(last_hid_function != hid_function) {
-        print_hid_function("CONTROLE");
-        last_hid_function = hid_function;
-      }
       hid_control_task();
       break;
     default:
       break;
   }
+
+  if (tud_hid_n_ready(keyboard_queue.instance)) {
+    if (!hid_queue_empty(&keyboard_queue)) {
+      keyboard_report_send();
+      hid_rate_deadline(&keyboard_rate);
+    } else if (hid_function == 1 || hid_function == 2) {
+      hid_rate_idle(&keyboard_rate, time_us_32());
+    }
+  }
+  if (tud_hid_n_ready(mouse_queue.instance) &&
+      (hid_function == 0 || !hid_queue_empty(&mouse_queue))) {
+    hid_mouse_task(hid_function == 0);
+    hid_rate_deadline(&mouse_rate);
+  }
+  // Fora da função gamepad, o gamepad ainda envia os botões soltos e,
+  // uma vez, os eixos centralizados, para o computador não ficar com o
+  // último desvio do joystick
+  bool gamepad_centering = gamepad_sent_x || gamepad_sent_y;
+  if (tud_hid_n_ready(gamepad_queue.instance) &&
+      (hid_function == 3 || gamepad_centering || !hid_queue_empty(&gamepad_queue))) {
+    hid_gamepad_task(hid_function == 3);
+    hid_rate_deadline(&gamepad_rate);
+  }
+}
+
+// Tarefa dos relatórios HID: lê o botão BOOTSEL e despacha relatórios
+void hid_task(void) {
+  static uint32_t start_ms = 0;
+
+  uint32_t elapsed_ms = board_millis() - start_ms;
+  if (elapsed_ms >= BOARD_BUTTON_INTERVAL_MS) {
+    // Depois da suspensão ou da calibração, que não executam esta tarefa,
+    // recomeça a contagem em vez de ler o botão uma vez por intervalo
+    // perdido sem dormir
+    start_ms = elapsed_ms >= 2 * BOARD_BUTTON_INTERVAL_MS ?
+      board_millis() : start_ms + BOARD_BUTTON_INTERVAL_MS;
+
+    // O botão BOOTSEL não tem interrupção: é lido a cada intervalo. Os
+    // eventos entram na mesma fila das interrupções, que ficam desligadas.
+    // A leitura desliga o acesso à flash, então o núcleo 1, que executa
+    // da flash, fica parado durante ela
+    multicore_lockout_start_blocking();
+    uint32_t const btn = board_button_read();
+    multicore_lockout_end_blocking();
+    uint32_t interrupts = save_and_disable_interrupts();
+    button_poll(BUTTON_BOARD, btn);
+    restore_interrupts(interrupts);
+  }
+  power_deadline_after((board_millis() - start_ms) * 1000, BOARD_BUTTON_INTERVAL_MS * 1000);
+
+  hid_report_task();
+}
+
+// Desenha a latência de ponta a ponta da função atual: mediana, percentil
+// 99 e o histograma das faixas em barras
+static void ui_render_latency(uint function) {
+  const latency_histogram_t *histogram = latency_histogram(function, LATENCY_INPUT_TO_HOST);
+  char line[20];
+
+  // Volta a linha inicial ao topo, caso o console tenha rolado a tela
+  ssd1306_console_clear(&ui_console);
+  display_draw_string(hid_function_names[function], 0, 0);
+  snprintf(line, sizeof(line), "N %lu", (unsigned long)histogram->count);
+  display_draw_string(line, 0, 10);
+  uint32_t p50 = latency_percentile(histogram, 50);
+  snprintf(line, sizeof(line), "P50 %lu.%luMS", (unsigned long)(p50 / 1000), (unsigned long)(p50 % 1000 / 100));
+  display_draw_string(line, 0, 20);
+  uint32_t p99 = latency_percentile(histogram, 99);
+  snprintf(line, sizeof(line), "P99 %lu.%luMS", (unsigned long)(p99 / 1000), (unsigned long)(p99 % 1000 / 100));
+  display_draw_string(line, 0, 30);
+
+  // Barras de 10 pixels por faixa, proporcionais à faixa mais cheia
+  const uint bar_bottom = 63, bar_height = 22;
+  uint32_t tallest = 0;
+  for (uint i = 0; i < LATENCY_BUCKETS; ++i) {
+    if (histogram->buckets[i] > tallest) tallest = histogram->buckets[i];
+  }
+  for (uint i = 0; i < LATENCY_BUCKETS && tallest; ++i) {
+    uint height = (uint64_t)histogram->buckets[i] * bar_height / tallest;
+    if (histogram->buckets[i] && !height) height = 1;
+    display_draw_rectangle(bar_bottom + 1 - height, 4 + i * 10, 8, height, true, true);
+  }
+}
+
+// Acrescenta uma linha ao console do display
+static void ui_console_line(const char *text) {
+  if (ui_console.row || ui_console.column) ssd1306_console_newline(&ui_console);
+  ssd1306_console_write(&ui_console, text);
+}
+
+// Desenha o estado atual no display. Fora da tela de latências, cada
+// troca de função e cada caractere escolhido no modo teclado viram uma
+// linha do console; com a tela cheia, ela rola uma linha e só a página
+// nova vai para o barramento
+static void ui_render(const ui_state_t *state) {
+  static int rendered_function = -1;
+  static uint8_t rendered_character = 0;
+
+  uint function = state->function;
+  if (state->latency) {
+    ui_render_latency(function);
+    rendered_function = -1;
+    display_send_data();
+    return;
+  }
+
+  // Primeiro quadro ou saída da tela de latências: recomeça o registro
+  if (rendered_function < 0) ssd1306_console_clear(&ui_console);
+
+  if (rendered_function != (int)function) {
+    ui_console_line(hid_function_names[function]);
+    rendered_function = function;
+  }
+
+  if (function == 1 && state->character >= HID_KEY_A && state->character != rendered_character) {
+    char character_message[50];
+    sprintf(character_message, "CARACTERE %c", convertHIDKeyToASCII(state->character));
+    ui_console_line(character_message);
+    rendered_character = state->character;
+  }
+
+  display_send_data();
+}
+
+// Publica o estado atual da interface para o núcleo 1. Retorna false com
+// o canal cheio
+static bool ui_publish(void) {
+  ui_state_t state = {
+    .function = hid_function,
+    .character = keyboard_character,
+    .latency = ui_latency,
+    .display_on = ui_display_on,
+  };
+  if (!ui_channel_push(&ui_channel, &state)) return false;
+  ui_changed = false;
+  return true;
+}
+
+// Tarefa da interface no núcleo 0: só publica o estado quando ele muda. O
+// desenho e o barramento do display ficam com o núcleo 1
+void ui_task(void) {
+  if (ui_changed && !ui_publish()) power_deadline_in(UI_CHANNEL_RETRY_US);
+}
+
+// Liga ou desliga o painel pelo núcleo 1. Ao desligar, espera o núcleo 1
+// concluir o envio em andamento e apagar o painel, para que o clock do
+// I2C possa mudar com o do sistema
+void ui_display_power(bool on) {
+  ui_display_on = on;
+  ui_notify();
+  while (!ui_publish()) {
+    tight_loop_contents();
+  }
+  if (!on) ui_channel_wait(&ui_channel);
+}
+
+// Uma volta do núcleo 1: aplica os estados publicados pelo núcleo 0 e
+// redesenha a tela no máximo UI_MAX_FPS vezes por segundo, nunca com um
+// quadro ainda no barramento. A tela de latências e a saída serial leem os
+// histogramas que o núcleo 0 preenche; podem misturar contagens de antes e
+// depois de um relatório, o que só afeta o que é exibido. Retorna quanto tempo o
+// núcleo pode dormir, ou UINT32_MAX se só uma nova mensagem o acorda
+uint32_t ui_core1_task(void) {
+  static ui_state_t state = { .display_on = true };
+  static bool changed = false;
+  static uint32_t last_frame_ms = 0;
+  static bool latency_printed = false;
+
+  // Aplica as mensagens na ordem; só o estado mais recente é desenhado
+  ui_state_t message;
+  while (ui_channel_peek(&ui_channel, &message)) {
+    if (message.display_on != state.display_on) display_power(message.display_on);
+    state = message;
+    changed = true;
+    ui_channel_pop(&ui_channel);
+  }
+
+  uint32_t wait_us = UINT32_MAX;
+  if (!state.display_on) return wait_us;
+
+  // Conclui envios em andamento e despacha mudanças pendentes
+  display_task();
+  if (display_busy()) wait_us = UI_DISPLAY_POLL_US;
+
+  // A tela de latências é redesenhada periodicamente com os novos valores
+  uint32_t elapsed_ms = board_millis() - last_frame_ms;
+  if (state.latency && elapsed_ms >= UI_LATENCY_REFRESH_MS) changed = true;
+  if (state.latency && !changed) {
+    wait_us = MIN(wait_us, (UI_LATENCY_REFRESH_MS - elapsed_ms) * 1000);
+  }
+
+  if (changed && elapsed_ms < 1000 / UI_MAX_FPS) {
+    wait_us = MIN(wait_us, (1000 / UI_MAX_FPS - elapsed_ms) * 1000);
+  } else if (changed && ssd1306_poll(&ssd)) {
+    last_frame_ms = board_millis();
+    changed = false;
+    ui_render(&state);
+    // Ao abrir a tela de latências, os histogramas também vão para a
+    // saída serial. A escrita bloqueia até a UART esvaziar (uns 200 ms a
+    // 115200 baud), por isso fica neste núcleo, depois do quadro, e não
+    // no laço do USB
+    if (state.latency && !latency_printed) latency_print_all();
+    latency_printed = state.latency;
+    // O quadro acabou de sair: volta logo para acompanhar o envio
+    wait_us = 0;
+  }
+  return wait_us;
+}
+
+// Laço do núcleo 1. Dorme até o próximo quadro ou até o núcleo 0 publicar
+// um estado, que acorda este núcleo com SEV
+void ui_core1_main(void) {
+  // Permite ao núcleo 0 parar este núcleo enquanto a flash está inacessível
+  multicore_lockout_victim_init();
+
+  while (1) {
+    uint32_t wait_us = ui_core1_task();
+    if (wait_us == UINT32_MAX) {
+      __wfe();
+    } else if (wait_us) {
+      best_effort_wfe_or_timeout(make_timeout_time_us(wait_us));
+    }
+  }
 }
 
 // Tarefa para piscar o LED
@@ -305,11 +923,25 @@ void led_blinking_task(void) {
   static bool led_state = false;
 
   if (!blink_interval_ms) return;
-  if (board_millis() - start_ms < blink_interval_ms) return;
+  uint32_t elapsed_ms = board_millis() - start_ms;
+  if (elapsed_ms >= blink_interval_ms) {
+    start_ms = elapsed_ms >= 2 * blink_interval_ms ?
+      board_millis() : start_ms + blink_interval_ms;
+    board_led_write(led_state);
+    led_state = !led_state;
+  }
+  power_deadline_after((board_millis() - start_ms) * 1000, blink_interval_ms * 1000);
+}
+
+// Callback chamado quando o computador recebe um relatório da interface
+void tud_hid_report_complete_cb(uint8_t instance, uint8_t const* report, uint16_t len) {
+  (void)report;
+  (void)len;
 
-  start_ms += blink_interval_ms;
-  board_led_write(led_state);
-  led_state = !led_state;
+  latency_report_complete(instance);
+  power_report_complete();
+  // O endpoint está livre: envia o próximo relatório sem esperar o laço
+  hid_report_task();
 }
 
 // Callback para receber um relatório HID do host (opcional)
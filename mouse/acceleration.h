@@ -0,0 +1,78 @@
+// Aceleração do cursor. A posição do joystick passa por uma curva que mistura
+// uma reta com uma cúbica: perto do centro o ganho é baixo, para movimentos
+// finos, e cresce até a velocidade máxima nas bordas. A curva é tabelada na
+// inicialização e interpolada a cada relatório.
+//
+// As velocidades são dadas por período de MOUSE_ACCEL_PERIOD_US e aplicadas
+// proporcionalmente ao tempo desde o relatório anterior, então o cursor anda
+// igual qualquer que seja a taxa de relatórios. Elas têm parte fracionária;
+// o que não chega a um ponto inteiro fica acumulado no eixo e é somado ao
+// próximo relatório
+
+// Pontos da tabela, igualmente espaçados de 0 a JOYSTICK_SCALE
+#define MOUSE_ACCEL_SEGMENTS 32
+#define MOUSE_ACCEL_STEP (JOYSTICK_SCALE / MOUSE_ACCEL_SEGMENTS)
+// Bits fracionários das velocidades e do acumulador
+#define MOUSE_ACCEL_FRACTION 8
+// Período ao qual as velocidades se referem
+#define MOUSE_ACCEL_PERIOD_US 10000
+// Maior intervalo considerado entre relatórios, para o cursor não saltar
+// depois de uma pausa
+#define MOUSE_ACCEL_MAX_ELAPSED_US (4 * MOUSE_ACCEL_PERIOD_US)
+
+// Velocidade, em pontos por MOUSE_ACCEL_PERIOD_US com MOUSE_ACCEL_FRACTION
+// bits, para cada ponto da curva
+static uint16_t mouse_accel_table[MOUSE_ACCEL_SEGMENTS + 1];
+
+typedef struct {
+  // Deslocamento acumulado, em pontos com MOUSE_ACCEL_FRACTION bits vezes
+  // microssegundos por período, para não perder velocidades pequenas
+  int32_t remainder;
+} mouse_axis_t;
+
+// Valor do acumulador equivalente a um ponto
+#define MOUSE_ACCEL_UNIT ((1 << MOUSE_ACCEL_FRACTION) * MOUSE_ACCEL_PERIOD_US)
+
+// Monta a tabela para a velocidade máxima (pontos por período) e o
+// formato dados. shape vai de 0 (reta) a 256 (cúbica): quanto maior, mais
+// lento o cursor perto do centro
+void mouse_acceleration_init(uint max_speed, uint shape) {
+  for (uint i = 0; i <= MOUSE_ACCEL_SEGMENTS; ++i) {
+    // Posição relativa em Q16
+    uint64_t t = ((uint64_t)i << 16) / MOUSE_ACCEL_SEGMENTS;
+    uint64_t cube = (((t * t) >> 16) * t) >> 16;
+    uint64_t curve = (t * (256 - shape) + cube * shape) >> 8;
+    mouse_accel_table[i] = (curve * max_speed << MOUSE_ACCEL_FRACTION) >> 16;
+  }
+}
+
+// Converte a posição de um eixo no deslocamento do próximo relatório,
+// enviado elapsed_us depois do anterior
+int8_t mouse_acceleration_apply(mouse_axis_t *axis, int16_t position, uint32_t elapsed_us) {
+  // No centro não sobra movimento acumulado para o próximo toque
+  if (position == 0) {
+    axis->remainder = 0;
+    return 0;
+  }
+
+  uint magnitude = position < 0 ? -position : position;
+  if (magnitude > JOYSTICK_SCALE) magnitude = JOYSTICK_SCALE;
+
+  uint segment = magnitude / MOUSE_ACCEL_STEP;
+  uint offset = magnitude % MOUSE_ACCEL_STEP;
+  int32_t speed = mouse_accel_table[segment];
+  if (segment < MOUSE_ACCEL_SEGMENTS) {
+    speed += ((int32_t)mouse_accel_table[segment + 1] - speed) * (int32_t)offset / MOUSE_ACCEL_STEP;
+  }
+
+  if (elapsed_us > MOUSE_ACCEL_MAX_ELAPSED_US) elapsed_us = MOUSE_ACCEL_MAX_ELAPSED_US;
+  int32_t distance = speed * (int32_t)elapsed_us;
+
+  axis->remainder += position < 0 ? -distance : distance;
+  // Divisão truncando em direção a zero, igual nos dois sentidos
+  int32_t delta = axis->remainder / MOUSE_ACCEL_UNIT;
+  if (delta > INT8_MAX) delta = INT8_MAX;
+  if (delta < -INT8_MAX) delta = -INT8_MAX;
+  axis->remainder -= delta * MOUSE_ACCEL_UNIT;
+  return delta;
+}
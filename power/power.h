@@ -0,0 +1,138 @@
+// Laço principal sem espera ativa. A cada volta, cada tarefa informa o
+// instante em que volta a ter trabalho (power_deadline_at/in) e o núcleo
+// dorme em WFE até o menor desses prazos. Qualquer interrupção (alarme dos
+// botões, borda de GPIO, USB) também acorda o núcleo: a entrada de uma
+// exceção marca o registrador de eventos, então uma interrupção que chega
+// entre a última tarefa e o WFE não se perde.
+//
+// Com o USB suspenso, o clock do sistema cai para os 48 MHz do PLL do USB
+// (o PLL do sistema é desligado), o ADC e o display param e só os botões,
+// por interrupção de GPIO, acordam o dispositivo e o computador (remote
+// wakeup)
+
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+#include "hardware/sync.h"
+#include "tusb.h"
+
+static struct {
+  // Menor prazo informado pelas tarefas nesta volta do laço
+  uint64_t deadline_us;
+  // Tempo total dormindo e quantidade de despertares desde o início
+  // da contagem
+  uint64_t since_us;
+  uint64_t sleep_us;
+  uint32_t wakeups;
+  // Clock do sistema antes da suspensão, restaurado na retomada
+  uint32_t sys_khz;
+  bool suspended;
+  bool remote_wakeup_enabled;
+  // Pedido de remote wakeup em andamento: instante do pedido e se o
+  // primeiro relatório depois da retomada ainda não foi entregue
+  bool wakeup_requested;
+  bool wakeup_report_pending;
+  uint32_t wakeup_us;
+  // Último tempo do pedido de remote wakeup até a retomada e até a
+  // entrega do primeiro relatório
+  uint32_t wakeup_to_resume_us;
+  uint32_t wakeup_to_report_us;
+} power;
+
+// Começa uma volta do laço sem prazo
+void power_deadline_reset() {
+  power.deadline_us = UINT64_MAX;
+}
+
+// Informa um prazo absoluto, em microssegundos desde a inicialização
+void power_deadline_at(uint64_t time_us) {
+  if (time_us < power.deadline_us) power.deadline_us = time_us;
+}
+
+// Informa um prazo relativo ao instante atual
+void power_deadline_in(uint32_t delay_us) {
+  power_deadline_at(time_us_64() + delay_us);
+}
+
+// Informa o fim de um intervalo de interval_us que já dura elapsed_us
+void power_deadline_after(uint32_t elapsed_us, uint32_t interval_us) {
+  power_deadline_in(elapsed_us < interval_us ? interval_us - elapsed_us : 0);
+}
+
+// Dorme até o prazo mais próximo ou até uma interrupção
+void power_sleep() {
+  uint64_t now = time_us_64();
+  if (power.deadline_us <= now) return;
+
+  // Sem prazo, não há alarme para armar: só uma interrupção acorda
+  if (power.deadline_us == UINT64_MAX) {
+    __wfe();
+  } else {
+    best_effort_wfe_or_timeout(from_us_since_boot(power.deadline_us));
+  }
+
+  power.sleep_us += time_us_64() - now;
+  power.wakeups++;
+}
+
+// Zera as estatísticas de sono
+void power_stats_reset() {
+  power.since_us = time_us_64();
+  power.sleep_us = 0;
+  power.wakeups = 0;
+}
+
+// Fração do tempo dormindo desde o início da contagem, em décimos de
+// porcentagem
+uint32_t power_idle_permille() {
+  uint64_t elapsed = time_us_64() - power.since_us;
+  return elapsed ? power.sleep_us * 1000 / elapsed : 0;
+}
+
+// Despertares por segundo desde o início da contagem
+uint32_t power_wakeups_per_second() {
+  uint64_t elapsed = time_us_64() - power.since_us;
+  return elapsed ? (uint64_t)power.wakeups * 1000000 / elapsed : 0;
+}
+
+// Entra em suspensão: reduz o clock do sistema para os 48 MHz do PLL do
+// USB, que continua ligado. O chamador para antes os periféricos que
+// dependem do clock do sistema (I2C do display)
+void power_suspend(bool remote_wakeup_enabled) {
+  power.remote_wakeup_enabled = remote_wakeup_enabled;
+  if (power.suspended) return;
+  power.suspended = true;
+  power.wakeup_requested = false;
+  power.sys_khz = clock_get_hz(clk_sys) / 1000;
+  set_sys_clock_48mhz();
+}
+
+// Sai da suspensão restaurando o clock do sistema
+void power_resume() {
+  if (!power.suspended) return;
+  set_sys_clock_khz(power.sys_khz, true);
+  power.suspended = false;
+  if (power.wakeup_requested) {
+    power.wakeup_requested = false;
+    power.wakeup_report_pending = true;
+    power.wakeup_to_resume_us = time_us_32() - power.wakeup_us;
+  }
+}
+
+// Pede ao computador para sair da suspensão, uma vez por suspensão. Só
+// é feito se o computador habilitou o remote wakeup
+bool power_request_wakeup() {
+  if (!power.suspended || !power.remote_wakeup_enabled) return false;
+  if (power.wakeup_requested) return true;
+  if (!tud_remote_wakeup()) return false;
+  power.wakeup_requested = true;
+  power.wakeup_us = time_us_32();
+  return true;
+}
+
+// Chamada quando o computador recebe um relatório: o primeiro depois de
+// um remote wakeup fecha a medição
+void power_report_complete() {
+  if (!power.wakeup_report_pending) return;
+  power.wakeup_report_pending = false;
+  power.wakeup_to_report_us = time_us_32() - power.wakeup_us;
+}
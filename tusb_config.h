@@ -91,7 +91,8 @@
 #endif
 
 //------------- CLASS -------------//
-#define CFG_TUD_HID               1
+// Uma interface HID para cada tipo: teclado, mouse e controle de jogo
+#define CFG_TUD_HID               3
 #define CFG_TUD_CDC               0
 #define CFG_TUD_MSC               0
 #define CFG_TUD_MIDI              0
@@ -0,0 +1,67 @@
+// Canal do estado da interface, do núcleo 0 (entradas e USB) para o
+// núcleo 1 (display). É um anel de produtor único e consumidor único, sem
+// trava: só o núcleo 0 escreve head e só o núcleo 1 escreve tail.
+//
+// Cada mensagem é o estado completo a exibir; o núcleo 1 desenha só o
+// mais recente. Depois de publicar, o núcleo 0 executa SEV para acordar o
+// núcleo 1, que dorme em WFE quando não tem o que desenhar
+
+#include "hardware/sync.h"
+
+// Capacidade do canal; precisa ser potência de 2
+#define UI_CHANNEL_SIZE 8
+
+typedef struct {
+  // Função atual e caractere selecionado no modo teclado
+  uint8_t function;
+  uint8_t character;
+  // Mostra os histogramas de latência no lugar do nome da função
+  bool latency;
+  // Painel ligado; desligado com o USB suspenso
+  bool display_on;
+} ui_state_t;
+
+typedef struct {
+  ui_state_t states[UI_CHANNEL_SIZE];
+  volatile uint32_t head;
+  volatile uint32_t tail;
+} ui_channel_t;
+
+// Publica um estado. Retorna false com o canal cheio; o chamador tenta de
+// novo depois
+bool ui_channel_push(ui_channel_t *channel, const ui_state_t *state) {
+  uint32_t head = channel->head;
+  if (head - channel->tail == UI_CHANNEL_SIZE) return false;
+
+  channel->states[head % UI_CHANNEL_SIZE] = *state;
+  // A mensagem precisa estar completa antes de ficar visível ao núcleo 1
+  __dmb();
+  channel->head = head + 1;
+  __sev();
+  return true;
+}
+
+// Lê a mensagem mais antiga sem retirá-la. Retorna false com o canal vazio
+bool ui_channel_peek(ui_channel_t *channel, ui_state_t *state) {
+  uint32_t tail = channel->tail;
+  if (tail == channel->head) return false;
+  __dmb();
+  *state = channel->states[tail % UI_CHANNEL_SIZE];
+  return true;
+}
+
+// Retira a mensagem mais antiga, já lida com ui_channel_peek. O núcleo 1
+// só retira a mensagem depois de aplicar o efeito dela no painel
+void ui_channel_pop(ui_channel_t *channel) {
+  // A leitura da mensagem termina antes de liberar a posição ao produtor
+  __dmb();
+  channel->tail = channel->tail + 1;
+}
+
+// Espera o núcleo 1 aplicar todas as mensagens publicadas
+void ui_channel_wait(ui_channel_t *channel) {
+  while (channel->tail != channel->head) {
+    tight_loop_contents();
+  }
+  __dmb();
+}
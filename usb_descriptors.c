@@ -75,12 +75,45 @@ uint8_t const * tud_descriptor_device_cb(void)
 // HID Report Descriptor
 //--------------------------------------------------------------------+
 
-uint8_t const desc_hid_report[] =
+// Each report type has its own interface; the report IDs are kept so the
+// reports look the same to the host as with a single interface
+
+uint8_t const desc_hid_keyboard_report[] =
 {
   TUD_HID_REPORT_DESC_KEYBOARD( HID_REPORT_ID(REPORT_ID_KEYBOARD         )),
-  TUD_HID_REPORT_DESC_MOUSE   ( HID_REPORT_ID(REPORT_ID_MOUSE            )),
-  TUD_HID_REPORT_DESC_CONSUMER( HID_REPORT_ID(REPORT_ID_CONSUMER_CONTROL )),
-  TUD_HID_REPORT_DESC_GAMEPAD ( HID_REPORT_ID(REPORT_ID_GAMEPAD          ))
+  TUD_HID_REPORT_DESC_CONSUMER( HID_REPORT_ID(REPORT_ID_CONSUMER_CONTROL ))
+};
+
+uint8_t const desc_hid_mouse_report[] =
+{
+  TUD_HID_REPORT_DESC_MOUSE   ( HID_REPORT_ID(REPORT_ID_MOUSE            ))
+};
+
+// Gamepad no formato de gamepad_report_t: eixos X e Y de 16 bits de
+// -GAMEPAD_AXIS_MAX a +GAMEPAD_AXIS_MAX e 8 botões
+uint8_t const desc_hid_gamepad_report[] =
+{
+  HID_USAGE_PAGE ( HID_USAGE_PAGE_DESKTOP     )                   ,
+  HID_USAGE      ( HID_USAGE_DESKTOP_GAMEPAD  )                   ,
+  HID_COLLECTION ( HID_COLLECTION_APPLICATION )                   ,
+    HID_REPORT_ID      ( REPORT_ID_GAMEPAD                        )
+    HID_USAGE_PAGE     ( HID_USAGE_PAGE_DESKTOP                   ) ,
+    HID_USAGE          ( HID_USAGE_DESKTOP_X                      ) ,
+    HID_USAGE          ( HID_USAGE_DESKTOP_Y                      ) ,
+    HID_LOGICAL_MIN_N  ( -GAMEPAD_AXIS_MAX, 2                     ) ,
+    HID_LOGICAL_MAX_N  ( GAMEPAD_AXIS_MAX, 2                      ) ,
+    HID_REPORT_COUNT   ( 2                                        ) ,
+    HID_REPORT_SIZE    ( 16                                       ) ,
+    HID_INPUT          ( HID_DATA | HID_VARIABLE | HID_ABSOLUTE   ) ,
+    HID_USAGE_PAGE     ( HID_USAGE_PAGE_BUTTON                    ) ,
+    HID_USAGE_MIN      ( 1                                        ) ,
+    HID_USAGE_MAX      ( 8                                        ) ,
+    HID_LOGICAL_MIN    ( 0                                        ) ,
+    HID_LOGICAL_MAX    ( 1                                        ) ,
+    HID_REPORT_COUNT   ( 8                                        ) ,
+    HID_REPORT_SIZE    ( 1                                        ) ,
+    HID_INPUT          ( HID_DATA | HID_VARIABLE | HID_ABSOLUTE   ) ,
+  HID_COLLECTION_END
 };
 
 // Invoked when received GET HID REPORT DESCRIPTOR
@@ -88,8 +121,12 @@ uint8_t const desc_hid_report[] =
 // Descriptor contents must exist long enough for transfer to complete
 uint8_t const * tud_hid_descriptor_report_cb(uint8_t instance)
 {
-  (void) instance;
-  return desc_hid_report;
+  switch (instance)
+  {
+    case HID_ITF_MOUSE:   return desc_hid_mouse_report;
+    case HID_ITF_GAMEPAD: return desc_hid_gamepad_report;
+    default:              return desc_hid_keyboard_report;
+  }
 }
 
 //--------------------------------------------------------------------+
@@ -98,13 +135,17 @@ uint8_t const * tud_hid_descriptor_report_cb(uint8_t instance)
 
 enum
 {
-  ITF_NUM_HID,
+  ITF_NUM_HID_KEYBOARD = HID_ITF_KEYBOARD,
+  ITF_NUM_HID_MOUSE    = HID_ITF_MOUSE,
+  ITF_NUM_HID_GAMEPAD  = HID_ITF_GAMEPAD,
   ITF_NUM_TOTAL
 };
 
-#define  CONFIG_TOTAL_LEN  (TUD_CONFIG_DESC_LEN + TUD_HID_DESC_LEN)
+#define  CONFIG_TOTAL_LEN  (TUD_CONFIG_DESC_LEN + HID_ITF_COUNT * TUD_HID_DESC_LEN)
 
-#define EPNUM_HID   0x81
+#define EPNUM_HID_KEYBOARD   0x81
+#define EPNUM_HID_MOUSE      0x82
+#define EPNUM_HID_GAMEPAD    0x83
 
 uint8_t const desc_configuration[] =
 {
@@ -112,7 +153,9 @@ uint8_t const desc_configuration[] =
   TUD_CONFIG_DESCRIPTOR(1, ITF_NUM_TOTAL, 0, CONFIG_TOTAL_LEN, TUSB_DESC_CONFIG_ATT_REMOTE_WAKEUP, 100),
 
   // Interface number, string index, protocol, report descriptor len, EP In address, size & polling interval
-  TUD_HID_DESCRIPTOR(ITF_NUM_HID, 0, HID_ITF_PROTOCOL_NONE, sizeof(desc_hid_report), EPNUM_HID, CFG_TUD_HID_EP_BUFSIZE, 5)
+  TUD_HID_DESCRIPTOR(ITF_NUM_HID_KEYBOARD, 0, HID_ITF_PROTOCOL_NONE, sizeof(desc_hid_keyboard_report), EPNUM_HID_KEYBOARD, CFG_TUD_HID_EP_BUFSIZE, HID_POLL_INTERVAL_MS),
+  TUD_HID_DESCRIPTOR(ITF_NUM_HID_MOUSE,    0, HID_ITF_PROTOCOL_NONE, sizeof(desc_hid_mouse_report),    EPNUM_HID_MOUSE,    CFG_TUD_HID_EP_BUFSIZE, HID_POLL_INTERVAL_MS),
+  TUD_HID_DESCRIPTOR(ITF_NUM_HID_GAMEPAD,  0, HID_ITF_PROTOCOL_NONE, sizeof(desc_hid_gamepad_report),  EPNUM_HID_GAMEPAD,  CFG_TUD_HID_EP_BUFSIZE, HID_POLL_INTERVAL_MS)
 };
 
 #if TUD_OPT_HIGH_SPEED
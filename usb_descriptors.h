@@ -25,6 +25,22 @@
 #ifndef USB_DESCRIPTORS_H_
 #define USB_DESCRIPTORS_H_
 
+// Intervalo de consulta do endpoint HID pelo computador (bInterval), em ms.
+// 1 ms é o menor permitido em full speed
+#ifndef HID_POLL_INTERVAL_MS
+#define HID_POLL_INTERVAL_MS 1
+#endif
+
+// Instâncias HID, uma interface com endpoint próprio para cada tipo de
+// relatório, para que um relatório em trânsito não segure os demais
+enum
+{
+  HID_ITF_KEYBOARD = 0,
+  HID_ITF_MOUSE,
+  HID_ITF_GAMEPAD,
+  HID_ITF_COUNT
+};
+
 enum
 {
   REPORT_ID_KEYBOARD = 1,
@@ -34,4 +50,16 @@ enum
   REPORT_ID_COUNT
 };
 
+// Os eixos do gamepad vão de -GAMEPAD_AXIS_MAX a +GAMEPAD_AXIS_MAX, a mesma
+// escala da posição calibrada do joystick (JOYSTICK_SCALE)
+#define GAMEPAD_AXIS_MAX 2048
+
+// Relatório do gamepad: eixos X e Y de 16 bits, com toda a resolução do
+// joystick, e 8 botões. O gamepad padrão do TinyUSB tem eixos de 8 bits
+typedef struct __attribute__((packed)) {
+  int16_t x;
+  int16_t y;
+  uint8_t buttons;
+} gamepad_report_t;
+
 #endif /* USB_DESCRIPTORS_H_ */